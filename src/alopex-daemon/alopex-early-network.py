@@ -6,11 +6,13 @@ Early boot network setup service
 
 import sys
 import os
+import socket
 import subprocess
 import json
 import logging
+from concurrent.futures import ThreadPoolExecutor, as_completed
 from pathlib import Path
-from typing import List, Dict, Optional
+from typing import List, Dict, Optional, Tuple
 
 class EarlyNetworkConfig:
     """Early boot network configuration for enterprise environments"""
@@ -163,57 +165,115 @@ class EarlyNetworkConfig:
             self.logger.error(f"Connectivity test failed for {interface}: {e}")
             return False
     
+    def configure_interface(self, interface: str,
+                            critical_networks: List[Dict]) -> Tuple[bool, bool]:
+        """Bring up and configure one interface end to end.
+
+        Returns (configured, connected). Runs on a worker thread - the
+        slow parts (DHCP wait, connectivity ping) only block this
+        interface, not the others.
+        """
+        if not self.bring_interface_up(interface):
+            return False, False
+
+        # Check for interface-specific configuration
+        interface_config = None
+        for config in critical_networks:
+            if config.get("interface") == interface:
+                interface_config = config
+                break
+
+        if interface_config:
+            # Configure based on specified method
+            method = interface_config.get("method", "dhcp")
+            if method == "static":
+                success = self.configure_static_ip(interface, interface_config)
+            else:
+                success = self.configure_dhcp(interface)
+        elif interface.startswith(('eth', 'eno', 'enp', 'ens')):
+            # Default to DHCP for ethernet interfaces
+            success = self.configure_dhcp(interface)
+        else:
+            return False, False
+
+        if not success:
+            return False, False
+
+        return True, self.test_connectivity(interface)
+
     def configure_critical_networks(self):
-        """Configure critical networks for early boot"""
+        """Configure critical networks for early boot.
+
+        Interfaces are brought up concurrently - a dead uplink burning
+        its DHCP timeout no longer delays the others - and the unit is
+        signalled ready as soon as the first interface passes its
+        connectivity test, while the remaining bring-ups finish in the
+        background before the process exits.
+        """
         critical_networks = self.load_critical_networks()
-        
+
         if not critical_networks:
             self.logger.info("No critical networks configured")
             return
-        
+
         interfaces = self.discover_interfaces()
         self.logger.info(f"Discovered interfaces: {', '.join(interfaces)}")
-        
+        if not interfaces:
+            return
+
         configured_count = 0
-        
-        for interface in interfaces:
-            # Bring interface up first
-            if not self.bring_interface_up(interface):
-                continue
-            
-            # Check for interface-specific configuration
-            interface_config = None
-            for config in critical_networks:
-                if config.get("interface") == interface:
-                    interface_config = config
-                    break
-            
-            if interface_config:
-                # Configure based on specified method
-                method = interface_config.get("method", "dhcp")
-                
-                if method == "static":
-                    success = self.configure_static_ip(interface, interface_config)
-                else:
-                    success = self.configure_dhcp(interface)
-                
-                if success:
+        ready_signalled = False
+
+        with ThreadPoolExecutor(max_workers=min(8, len(interfaces)),
+                                thread_name_prefix="alopex-early") as pool:
+            futures = {
+                pool.submit(self.configure_interface, iface, critical_networks): iface
+                for iface in interfaces
+            }
+            for future in as_completed(futures):
+                interface = futures[future]
+                try:
+                    configured, connected = future.result()
+                except Exception as e:
+                    self.logger.error(f"Bring-up failed for {interface}: {e}")
+                    continue
+
+                if configured:
                     configured_count += 1
-                    # Test connectivity
-                    self.test_connectivity(interface)
-            else:
-                # Default to DHCP for ethernet interfaces
-                if interface.startswith(('eth', 'eno', 'enp', 'ens')):
-                    if self.configure_dhcp(interface):
-                        configured_count += 1
-                        self.test_connectivity(interface)
-        
+                if connected and not ready_signalled:
+                    # First-success fast path: boot can proceed on this
+                    # uplink while the rest keep configuring
+                    ready_signalled = True
+                    self.logger.info(f"First uplink ready: {interface}")
+                    self._mark_ready(configured_count)
+                    self._notify_systemd_ready()
+
         self.logger.info(f"Early network configuration complete: {configured_count} interfaces configured")
-        
-        # Create state file to indicate early network is ready
-        state_file = self.state_path / "early-network-ready"
-        state_file.parent.mkdir(parents=True, exist_ok=True)
-        state_file.write_text(f"Early network configured at boot\nInterfaces: {configured_count}\n")
+        self._mark_ready(configured_count)
+
+    def _mark_ready(self, configured_count: int):
+        """Create/refresh the state file indicating early network is ready"""
+        try:
+            state_file = self.state_path / "early-network-ready"
+            state_file.parent.mkdir(parents=True, exist_ok=True)
+            state_file.write_text(f"Early network configured at boot\nInterfaces: {configured_count}\n")
+        except Exception as e:
+            self.logger.error(f"Failed to write ready state: {e}")
+
+    def _notify_systemd_ready(self):
+        """Send READY=1 so a Type=notify unit unblocks the boot ordering"""
+        notify_socket = os.environ.get("NOTIFY_SOCKET")
+        if not notify_socket:
+            return
+        try:
+            # Abstract namespace sockets are announced with a leading '@'
+            if notify_socket.startswith("@"):
+                notify_socket = "\0" + notify_socket[1:]
+            sock = socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM)
+            sock.sendto(b"READY=1", notify_socket)
+            sock.close()
+        except OSError as e:
+            self.logger.warning(f"sd_notify failed: {e}")
 
 def main():
     """Main entry point for early network configuration"""
@@ -223,6 +283,10 @@ def main():
     
     early_config = EarlyNetworkConfig()
     early_config.configure_critical_networks()
+    # Degraded boot (no uplink passed its connectivity test, or nothing
+    # to configure) must still release the Type=notify ordering; a
+    # duplicate READY=1 after the fast path is a no-op to systemd
+    early_config._notify_systemd_ready()
 
 if __name__ == "__main__":
     main()
\ No newline at end of file
@@ -6,7 +6,11 @@ System-level network management service
 
 import sys
 import os
+import grp
+import mmap
 import signal
+import socket
+import struct
 import asyncio
 import logging
 import json
@@ -20,10 +24,74 @@ sys.path.insert(0, str(Path(__file__).parent.parent / "alopex-qt"))
 
 from network.discovery import NetworkDiscovery, NetworkInterface
 from network.system_integration import NetworkControl
-from network.wifi import WiFiManager  
+from network.wifi import WiFiManager
 from network.vpn import VpnManager
 from network.connection_manager import ConnectionManager
 
+# Control socket shared by nmcli-compat and the GUI. The socket exposes
+# mutating operations (connect/disconnect), so it is root plus one
+# trusted group, never world-writable.
+CONTROL_SOCKET_PATH = "/run/alopex/alopexd.sock"
+CONTROL_SOCKET_GROUP = "alopex"
+CONTROL_MAX_REQUEST = 65536  # bytes per request line
+
+# rtnetlink multicast groups (linux/rtnetlink.h)
+RTMGRP_LINK = 0x01
+RTMGRP_IPV4_IFADDR = 0x10
+RTMGRP_IPV4_ROUTE = 0x40
+
+class TelemetryRing:
+    """Shared-memory ring of telemetry snapshots.
+
+    Collectors map the file read-only and follow write_seq instead of
+    re-reading a JSON file the daemon keeps rewriting; the daemon never
+    touches disk on the telemetry hot path. Each snapshot goes into the
+    slot write_seq % SLOT_COUNT and the sequence counter is bumped last,
+    so a reader that sees seq N can safely consume slots up to N.
+    """
+
+    MAGIC = 0x414C5052  # "ALPR"
+    SLOT_COUNT = 64
+    SLOT_SIZE = 16384
+    HEADER = struct.Struct("<IIIQ")  # magic, slot_count, slot_size, write_seq
+
+    def __init__(self, path: str = "/dev/shm/alopex-telemetry"):
+        self.path = path
+        size = self.HEADER.size + self.SLOT_COUNT * self.SLOT_SIZE
+        fd = os.open(path, os.O_RDWR | os.O_CREAT, 0o644)
+        try:
+            os.ftruncate(fd, size)
+            self.mm = mmap.mmap(fd, size)
+        finally:
+            os.close(fd)
+        self.write_seq = 0
+        self.mm[:self.HEADER.size] = self.HEADER.pack(
+            self.MAGIC, self.SLOT_COUNT, self.SLOT_SIZE, 0)
+
+    def publish(self, snapshot: dict) -> bool:
+        """Write one snapshot into the next slot and advance the sequence"""
+        payload = json.dumps(snapshot).encode()
+        if len(payload) + 4 > self.SLOT_SIZE:
+            return False
+
+        slot = self.write_seq % self.SLOT_COUNT
+        offset = self.HEADER.size + slot * self.SLOT_SIZE
+        self.mm[offset:offset + 4] = struct.pack("<I", len(payload))
+        self.mm[offset + 4:offset + 4 + len(payload)] = payload
+
+        # Sequence bump is the publish barrier - readers only trust
+        # slots at or below the sequence they observe
+        self.write_seq += 1
+        self.mm[:self.HEADER.size] = self.HEADER.pack(
+            self.MAGIC, self.SLOT_COUNT, self.SLOT_SIZE, self.write_seq)
+        return True
+
+    def close(self):
+        try:
+            self.mm.close()
+        except Exception:
+            pass
+
 class AlopexDaemon:
     """Enterprise network management daemon"""
     
@@ -33,7 +101,11 @@ class AlopexDaemon:
         self.running = False
         self.config_path = Path("/etc/alopex")
         self.state_path = Path("/var/lib/alopex")
-        
+
+        # Telemetry publishing state
+        self.telemetry_ring: Optional[TelemetryRing] = None
+        self.latest_telemetry: Optional[dict] = None
+
         # Enterprise configuration
         self.enterprise_config = self._load_enterprise_config()
         
@@ -177,66 +249,324 @@ class AlopexDaemon:
         except Exception as e:
             self.logger.error(f"Ethernet auto-connect failed: {e}")
     
+    def _create_rtnetlink_socket(self) -> Optional[socket.socket]:
+        """Subscribe to kernel link/address/route change notifications"""
+        try:
+            sock = socket.socket(socket.AF_NETLINK, socket.SOCK_RAW,
+                                 socket.NETLINK_ROUTE)
+            sock.bind((0, RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV4_ROUTE))
+            sock.setblocking(False)
+            return sock
+        except Exception as e:
+            self.logger.warning(f"rtnetlink subscription unavailable: {e}")
+            return None
+
     async def monitor_network_changes(self):
-        """Monitor for network interface changes"""
+        """Monitor for network interface changes.
+
+        Event-driven: the kernel pushes rtnetlink notifications the
+        moment a link, address or route changes, so reaction is
+        immediate and the daemon is idle between changes. A slow
+        periodic resync remains as a safety net; if the netlink
+        subscription cannot be established we fall back to the old
+        5-second poll.
+        """
         previous_interfaces = {}
-        
-        while self.running:
-            try:
-                current_interfaces = {
-                    iface.name: iface for iface in self.discovery.discover_interfaces()
-                }
-                
-                # Detect new interfaces
-                for name, interface in current_interfaces.items():
-                    if name not in previous_interfaces:
-                        self.logger.info(f"New interface detected: {name} ({interface.interface_type})")
-                        # Attempt auto-connection for new interfaces
-                        if interface.interface_type in ["WiFi", "Ethernet"]:
-                            await self.auto_connect_networks()
-                    
-                    # Detect status changes
-                    elif previous_interfaces[name].status != interface.status:
-                        self.logger.info(f"Interface {name} status: {previous_interfaces[name].status} -> {interface.status}")
-                        
-                        # Reconnect if disconnected unexpectedly
-                        if interface.status == "Disconnected" and previous_interfaces[name].status == "Connected":
-                            self.logger.warning(f"Interface {name} disconnected, attempting reconnection")
-                            await self.auto_connect_networks()
-                
-                previous_interfaces = current_interfaces
-                await asyncio.sleep(5)  # Monitor every 5 seconds
-                
-            except Exception as e:
-                self.logger.error(f"Network monitoring error: {e}")
-                await asyncio.sleep(10)  # Back off on errors
+        change_pending = asyncio.Event()
+        loop = asyncio.get_running_loop()
+
+        nl_sock = self._create_rtnetlink_socket()
+        if nl_sock:
+            def _on_netlink_event():
+                # Drain everything queued - we only need the wakeup, the
+                # diff below re-reads authoritative state from sysfs
+                try:
+                    while True:
+                        if not nl_sock.recv(65536):
+                            break
+                except (BlockingIOError, InterruptedError):
+                    pass
+                except OSError as e:
+                    self.logger.warning(f"rtnetlink receive error: {e}")
+                change_pending.set()
+
+            loop.add_reader(nl_sock.fileno(), _on_netlink_event)
+            resync_interval = 60  # safety net only
+            self.logger.info("Subscribed to rtnetlink change notifications")
+        else:
+            resync_interval = 5  # legacy polling fallback
+
+        try:
+            while self.running:
+                try:
+                    try:
+                        await asyncio.wait_for(change_pending.wait(),
+                                               timeout=resync_interval)
+                        # Debounce: interface flaps arrive in bursts
+                        await asyncio.sleep(0.5)
+                    except asyncio.TimeoutError:
+                        pass  # periodic resync
+                    change_pending.clear()
+
+                    current_interfaces = {
+                        iface.name: iface for iface in self.discovery.discover_interfaces()
+                    }
+
+                    # Detect new interfaces
+                    for name, interface in current_interfaces.items():
+                        if name not in previous_interfaces:
+                            self.logger.info(f"New interface detected: {name} ({interface.interface_type})")
+                            # Attempt auto-connection for new interfaces
+                            if interface.interface_type in ["WiFi", "Ethernet"]:
+                                await self.auto_connect_networks()
+
+                        # Detect status changes
+                        elif previous_interfaces[name].status != interface.status:
+                            self.logger.info(f"Interface {name} status: {previous_interfaces[name].status} -> {interface.status}")
+
+                            # Reconnect if disconnected unexpectedly
+                            if interface.status == "Disconnected" and previous_interfaces[name].status == "Connected":
+                                self.logger.warning(f"Interface {name} disconnected, attempting reconnection")
+                                await self.auto_connect_networks()
+
+                    previous_interfaces = current_interfaces
+
+                except asyncio.CancelledError:
+                    raise
+                except Exception as e:
+                    self.logger.error(f"Network monitoring error: {e}")
+                    await asyncio.sleep(10)  # Back off on errors
+        finally:
+            if nl_sock:
+                loop.remove_reader(nl_sock.fileno())
+                nl_sock.close()
     
     async def export_telemetry(self):
-        """Export network telemetry for enterprise monitoring"""
+        """Export network telemetry for enterprise monitoring.
+
+        Snapshots go into the shared-memory telemetry ring instead of
+        rewriting telemetry.json; publishing is a memcpy, so the
+        interval can be tighter than the old 30-second file rewrite
+        without touching disk. The latest snapshot also feeds the
+        Prometheus /metrics endpoint.
+        """
         if not self.enterprise_config.get("monitoring", {}).get("telemetry_enabled", True):
             return
-            
+
+        try:
+            self.telemetry_ring = TelemetryRing()
+        except Exception as e:
+            self.logger.error(f"Failed to create telemetry ring: {e}")
+            self.telemetry_ring = None
+
         while self.running:
             try:
                 interfaces = self.discovery.discover_interfaces()
+                self.discovery.update_speeds(interfaces)
                 telemetry_data = {
                     "timestamp": time.time(),
                     "interfaces": [asdict(iface) for iface in interfaces],
                     "daemon_status": "running",
-                    "connections_count": len(self.saved_connections)
+                    "connections_count": len(self.connection_manager.profiles)
                 }
-                
-                # Write to telemetry file for collection
-                telemetry_file = Path("/var/lib/alopex/telemetry.json")
-                with open(telemetry_file, 'w') as f:
-                    json.dump(telemetry_data, f)
-                
-                await asyncio.sleep(30)  # Export every 30 seconds
-                
+
+                self.latest_telemetry = telemetry_data
+                if self.telemetry_ring:
+                    self.telemetry_ring.publish(telemetry_data)
+
+                await asyncio.sleep(5)
+
             except Exception as e:
                 self.logger.error(f"Telemetry export failed: {e}")
                 await asyncio.sleep(60)
+
+    def _render_prometheus_metrics(self) -> str:
+        """Render the latest telemetry snapshot in Prometheus text format"""
+        lines = [
+            "# HELP alopex_daemon_up Whether the ALOPEX daemon is running",
+            "# TYPE alopex_daemon_up gauge",
+            f"alopex_daemon_up {1 if self.running else 0}",
+        ]
+
+        snapshot = self.latest_telemetry
+        if snapshot:
+            lines += [
+                "# HELP alopex_connection_profiles Number of saved connection profiles",
+                "# TYPE alopex_connection_profiles gauge",
+                f"alopex_connection_profiles {snapshot['connections_count']}",
+                "# HELP alopex_interface_up Interface connection state",
+                "# TYPE alopex_interface_up gauge",
+                "# HELP alopex_interface_bytes_total Interface byte counters",
+                "# TYPE alopex_interface_bytes_total counter",
+                "# HELP alopex_interface_packets_total Interface packet counters",
+                "# TYPE alopex_interface_packets_total counter",
+            ]
+            for iface in snapshot["interfaces"]:
+                name = iface["name"]
+                metrics = iface.get("metrics") or {}
+                up = 1 if iface.get("status") == "Connected" else 0
+                lines.append(f'alopex_interface_up{{interface="{name}"}} {up}')
+                for direction, byte_key, pkt_key in [("tx", "bytes_tx", "packets_tx"),
+                                                     ("rx", "bytes_rx", "packets_rx")]:
+                    lines.append(
+                        f'alopex_interface_bytes_total{{interface="{name}",direction="{direction}"}} '
+                        f'{metrics.get(byte_key, 0)}')
+                    lines.append(
+                        f'alopex_interface_packets_total{{interface="{name}",direction="{direction}"}} '
+                        f'{metrics.get(pkt_key, 0)}')
+
+        return "\n".join(lines) + "\n"
+
+    async def _handle_metrics_request(self, reader, writer):
+        """Minimal HTTP handler for the Prometheus scrape endpoint"""
+        try:
+            request_line = await asyncio.wait_for(reader.readline(), timeout=5)
+            # Drain remaining headers
+            while True:
+                header = await asyncio.wait_for(reader.readline(), timeout=5)
+                if header in (b"\r\n", b"\n", b""):
+                    break
+
+            parts = request_line.decode("latin-1").split()
+            path = parts[1] if len(parts) >= 2 else ""
+
+            if path.split("?")[0] == "/metrics":
+                body = self._render_prometheus_metrics().encode()
+                status = "200 OK"
+                content_type = "text/plain; version=0.0.4; charset=utf-8"
+            else:
+                body = b"Not Found\n"
+                status = "404 Not Found"
+                content_type = "text/plain; charset=utf-8"
+
+            writer.write((
+                f"HTTP/1.1 {status}\r\n"
+                f"Content-Type: {content_type}\r\n"
+                f"Content-Length: {len(body)}\r\n"
+                "Connection: close\r\n"
+                "\r\n"
+            ).encode() + body)
+            await writer.drain()
+        except Exception as e:
+            self.logger.debug(f"Metrics request error: {e}")
+        finally:
+            writer.close()
+
+    async def serve_metrics(self):
+        """Serve Prometheus metrics on the configured port"""
+        monitoring = self.enterprise_config.get("monitoring", {})
+        if not monitoring.get("telemetry_enabled", True):
+            return
+
+        port = monitoring.get("metrics_port", 9090)
+        try:
+            server = await asyncio.start_server(
+                self._handle_metrics_request, host="127.0.0.1", port=port)
+        except Exception as e:
+            self.logger.error(f"Failed to start metrics endpoint on port {port}: {e}")
+            return
+
+        self.logger.info(f"Prometheus metrics available on 127.0.0.1:{port}/metrics")
+        async with server:
+            await server.serve_forever()
     
+    async def _dispatch_control(self, op: str, args: dict) -> dict:
+        """Execute one control request against the resident managers"""
+        try:
+            if op == "ping":
+                data = "pong"
+            elif op == "interfaces":
+                data = [asdict(iface) for iface in self.discovery.discover_interfaces()]
+            elif op == "profiles":
+                data = {name: asdict(profile)
+                        for name, profile in self.connection_manager.profiles.items()}
+            elif op == "wifi_scan":
+                loop = asyncio.get_running_loop()
+                networks = await loop.run_in_executor(
+                    None, WiFiManager.scan_networks, args["device"])
+                data = [{
+                    "ssid": net.ssid,
+                    "signal_strength": net.signal_strength,
+                    "security": net.security.value,
+                    "frequency": net.frequency,
+                    "bssid": net.bssid,
+                    "connected": net.connected,
+                    "channel": net.channel,
+                } for net in networks]
+            elif op == "connect_profile":
+                data = await self.connection_manager.connect_profile(args["name"])
+            elif op == "disconnect_interface":
+                data = await self.connection_manager.disconnect_interface(args["interface"])
+            elif op == "auto_connect_interface":
+                data = await self.connection_manager.auto_connect_interface(args["interface"])
+            else:
+                return {"ok": False, "error": f"unknown op: {op}"}
+            return {"ok": True, "data": data}
+        except Exception as e:
+            self.logger.exception(f"Control request failed: {op}")
+            return {"ok": False, "error": str(e)}
+
+    async def _handle_control_client(self, reader, writer):
+        """Serve newline-delimited JSON requests from one client"""
+        try:
+            while True:
+                try:
+                    line = await reader.readline()
+                except (asyncio.LimitOverrunError, ValueError):
+                    # Request line exceeded the server limit - reject
+                    # and drop the client rather than buffering forever
+                    writer.write(json.dumps(
+                        {"ok": False, "error": "request too large"}).encode() + b"\n")
+                    await writer.drain()
+                    break
+                if not line:
+                    break
+                try:
+                    request = json.loads(line)
+                except json.JSONDecodeError:
+                    response = {"ok": False, "error": "invalid request"}
+                else:
+                    response = await self._dispatch_control(
+                        request.get("op", ""), request.get("args") or {})
+                writer.write(json.dumps(response).encode() + b"\n")
+                await writer.drain()
+        except (ConnectionResetError, BrokenPipeError):
+            pass
+        finally:
+            writer.close()
+
+    async def serve_control(self):
+        """Expose the resident managers over the control socket.
+
+        nmcli-compat and the GUI connect here instead of each paying
+        interpreter startup, module imports and their own discovery
+        subprocess storms - a request is one socket round-trip against
+        state the daemon already maintains.
+        """
+        socket_path = Path(CONTROL_SOCKET_PATH)
+        try:
+            socket_path.parent.mkdir(parents=True, exist_ok=True)
+            if socket_path.exists():
+                socket_path.unlink()
+            server = await asyncio.start_unix_server(
+                self._handle_control_client, path=str(socket_path),
+                limit=CONTROL_MAX_REQUEST)
+            try:
+                gid = grp.getgrnam(CONTROL_SOCKET_GROUP).gr_gid
+            except KeyError:
+                gid = 0
+                self.logger.warning(
+                    f"Group '{CONTROL_SOCKET_GROUP}' not found - control socket is root-only")
+            os.chown(socket_path, 0, gid)
+            os.chmod(socket_path, 0o660)
+        except Exception as e:
+            self.logger.error(f"Failed to start control socket: {e}")
+            return
+
+        self.logger.info(f"Control socket listening on {socket_path}")
+        async with server:
+            await server.serve_forever()
+
     def signal_handler(self, signum, frame):
         """Handle shutdown signals gracefully"""
         self.logger.info(f"Received signal {signum}, shutting down...")
@@ -260,6 +590,8 @@ class AlopexDaemon:
         tasks = [
             asyncio.create_task(self.monitor_network_changes()),
             asyncio.create_task(self.export_telemetry()),
+            asyncio.create_task(self.serve_metrics()),
+            asyncio.create_task(self.serve_control()),
             asyncio.create_task(self.connection_manager.monitor_connections()),
         ]
         
@@ -275,7 +607,10 @@ class AlopexDaemon:
             for task in tasks:
                 task.cancel()
             await asyncio.gather(*tasks, return_exceptions=True)
-            
+
+            if self.telemetry_ring:
+                self.telemetry_ring.close()
+
             # Save state
             self._save_connections()
 
@@ -15,9 +15,35 @@
 #include <bpf/bpf_core_read.h>
 
 #define MAX_ENTRIES 4096
+
+/* Compile-time defaults - used until userspace seeds alopex_config */
 #define ALERT_THRESHOLD_NETLINK 10
 #define ALERT_THRESHOLD_PRIV_ESC 1
+#define ALERT_THRESHOLD_PORTSCAN 16  /* distinct dest ports per source */
 #define TIME_WINDOW_SEC 60
+#define SEVERITY_BLOCKLIST 2
+#define SEVERITY_PORTSCAN 3
+
+/* Runtime-tunable configuration slots in alopex_config. Userspace
+ * (EBPFNetworkMonitor) updates these live from enterprise.json, so
+ * detection can be retuned under attack without a detach/reattach
+ * coverage gap. A zero slot means "not seeded" and falls back to the
+ * compile-time default above. */
+enum alopex_config_key {
+    CFG_NETLINK_THRESHOLD = 0,
+    CFG_PORTSCAN_THRESHOLD,
+    CFG_TIME_WINDOW_SEC,
+    CFG_FEATURE_DISABLE,
+    CFG_SEVERITY_BLOCKLIST,
+    CFG_SEVERITY_PORTSCAN,
+    CFG_CAPTURE_SAMPLE_N,   /* capture 1-in-N flagged packets; 0 disarms */
+    ALOPEX_CFG_MAX,
+};
+
+/* Bits for CFG_FEATURE_DISABLE. The slot is a disable mask so the
+ * zero-initialized (unseeded) state leaves every stage enabled. */
+#define ALOPEX_FEATURE_BLOCKLIST   (1 << 0)
+#define ALOPEX_FEATURE_SCAN_DETECT (1 << 1)
 
 /* Security event types */
 enum alopex_event_type {
@@ -40,41 +66,228 @@ struct alopex_security_event {
     __u32 netlink_type;
     __u32 interface_index;
     __u8 suspicious_pattern[32];
+    __u32 src_ip;    /* network byte order, 0 if not applicable */
+    __u32 count;     /* occurrences coalesced into this event */
+};
+
+/* Coalescing key: one ringbuf record per (type, source, pid) per window */
+struct alopex_alert_key {
+    __u32 event_type;
+    __u32 src_ip;
+    __u32 pid;
+};
+
+/* Per-source port-scan tracking state. The 64-bit bloom filter gives a
+ * probabilistic count of distinct destination ports probed by a source:
+ * a port only bumps the counter when its filter bits were clear, so
+ * repeated SYNs to the same port (a busy legitimate client) stay cheap
+ * while a scanner walking the port space saturates the counter fast.
+ * False sharing of bits can only undercount, never overcount. */
+struct alopex_scan_entry {
+    __u64 window_start;
+    __u64 port_bloom;
+    __u32 distinct_ports;
+    __u32 alerted;
 };
 
-/* Maps for tracking security events */
+/* LPM trie key for the runtime-managed network blocklist */
+struct alopex_lpm_key {
+    __u32 prefixlen;
+    __u32 addr;  /* network byte order */
+};
+
+/* Blocklist verdicts */
+#define ALOPEX_VERDICT_ALLOW 0
+#define ALOPEX_VERDICT_BLOCK 1
+
+/* Per-CPU XDP statistics slots */
+enum alopex_xdp_stat {
+    STAT_PACKETS_SEEN = 0,
+    STAT_PACKETS_PASSED,
+    STAT_PACKETS_DROPPED,
+    STAT_BLOCKLIST_HITS,
+    STAT_SYN_PACKETS,
+    STAT_TAIL_CALL_MISSES,
+    STAT_PACKETS_CAPTURED,
+    ALOPEX_XDP_STAT_MAX,
+};
+
+/* Tail-call pipeline slots in xdp_pipeline */
+#define XDP_PROG_SCAN_DETECT 0
+
+/* Rate-limit entry with embedded window timestamp so stale counters can
+ * be recognized in place instead of requiring an explicit cleanup pass */
+struct alopex_rate_entry {
+    __u64 window_start;
+    __u32 count;
+    __u32 pad;
+};
+
+/*
+ * Maps for tracking security events. All tracking maps are LRU variants:
+ * when a map fills up the kernel evicts the least-recently-used entry
+ * instead of failing bpf_map_update_elem(), so a busy host degrades
+ * gracefully rather than going blind once MAX_ENTRIES is reached.
+ * Time-based expiry (TIME_WINDOW_SEC) is handled in-kernel at access
+ * time where the value carries a timestamp, with a batched userspace
+ * sweep for entries that are never touched again.
+ */
 struct {
-    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(type, BPF_MAP_TYPE_LRU_HASH);
     __uint(max_entries, MAX_ENTRIES);
     __type(key, __u32);  /* PID */
     __type(value, struct alopex_security_event);
 } alopex_events SEC(".maps");
 
+/*
+ * Per-CPU rate tracking: each CPU increments its own slot so the hot
+ * netlink path never bounces a shared cache line between cores. The
+ * userspace monitor sums the per-CPU slots when evaluating
+ * ALERT_THRESHOLD_NETLINK globally; kernel-side we only do a cheap
+ * local-CPU check as a fast path.
+ */
 struct {
-    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(type, BPF_MAP_TYPE_LRU_PERCPU_HASH);
     __uint(max_entries, MAX_ENTRIES);
     __type(key, __u32);  /* UID */
-    __type(value, __u32); /* Event count */
+    __type(value, struct alopex_rate_entry); /* Count (this CPU only) */
 } netlink_rate_limit SEC(".maps");
 
 struct {
-    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(type, BPF_MAP_TYPE_LRU_HASH);
     __uint(max_entries, MAX_ENTRIES);
     __type(key, __u32);  /* PID */
     __type(value, __u64); /* Last privilege change timestamp */
 } privilege_tracking SEC(".maps");
 
+/*
+ * Alert coalescing state: during an incident (e.g. a SYN scan) the same
+ * (event_type, src, pid) tuple fires thousands of times per second.
+ * Only the first occurrence in a window reaches the ring buffer; repeats
+ * just bump the counter here and are folded into the next emission.
+ */
+struct {
+    __uint(type, BPF_MAP_TYPE_LRU_HASH);
+    __uint(max_entries, MAX_ENTRIES);
+    __type(key, struct alopex_alert_key);
+    __type(value, struct alopex_rate_entry);
+} alert_dedup SEC(".maps");
+
+/*
+ * Runtime blocklist/allowlist, populated by userspace from
+ * /etc/alopex/critical-networks.json. Longest-prefix match wins, so a
+ * narrow ALLOW entry can punch a hole in a broader BLOCK range.
+ */
+struct {
+    __uint(type, BPF_MAP_TYPE_LPM_TRIE);
+    __uint(max_entries, MAX_ENTRIES);
+    __uint(map_flags, BPF_F_NO_PREALLOC);
+    __type(key, struct alopex_lpm_key);
+    __type(value, __u8);  /* ALOPEX_VERDICT_* */
+} blocked_networks SEC(".maps");
+
+/* Per-source scan tracking, keyed by source address */
+struct {
+    __uint(type, BPF_MAP_TYPE_LRU_HASH);
+    __uint(max_entries, MAX_ENTRIES);
+    __type(key, __u32);  /* Source IP, network byte order */
+    __type(value, struct alopex_scan_entry);
+} scan_tracking SEC(".maps");
+
+/*
+ * Per-CPU packet counters for the XDP pipeline. Each CPU owns its own
+ * slots so the counters cost a single uncontended add on the fast path;
+ * userspace sums across CPUs when exporting telemetry.
+ */
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, ALOPEX_XDP_STAT_MAX);
+    __type(key, __u32);
+    __type(value, __u64);
+} xdp_stats SEC(".maps");
+
+/*
+ * Tail-call pipeline: the entry filter handles parsing and blocklist
+ * enforcement, then tail-calls into detection stages. The loader wires
+ * program fds into the slots; an unpopulated slot falls through to
+ * XDP_PASS so a partially-loaded pipeline fails open, not closed.
+ */
+struct {
+    __uint(type, BPF_MAP_TYPE_PROG_ARRAY);
+    __uint(max_entries, 4);
+    __type(key, __u32);
+    __type(value, __u32);
+} xdp_pipeline SEC(".maps");
+
 struct {
     __uint(type, BPF_MAP_TYPE_RINGBUF);
     __uint(max_entries, 256 * 1024);
 } security_alerts SEC(".maps");
 
+/*
+ * AF_XDP capture sockets, one slot per RX queue. While
+ * CFG_CAPTURE_SAMPLE_N is nonzero, sampled packets from flagged scan
+ * sources are redirected here zero-copy instead of traversing the
+ * stack for a side-loaded tcpdump. An empty slot makes
+ * bpf_redirect_map() fall back to XDP_PASS, so capture costs nothing
+ * when disarmed and fails open when the consumer is gone.
+ */
+struct {
+    __uint(type, BPF_MAP_TYPE_XSKMAP);
+    __uint(max_entries, 64);
+    __type(key, __u32);   /* RX queue index */
+    __type(value, __u32); /* AF_XDP socket fd */
+} capture_socks SEC(".maps");
+
+/*
+ * Runtime configuration, one __u64 slot per alopex_config_key. Array
+ * maps are preallocated and always-present, so the lookup on the hot
+ * path is a bounds check plus a load - no hashing.
+ */
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, ALOPEX_CFG_MAX);
+    __type(key, __u32);
+    __type(value, __u64);
+} alopex_config SEC(".maps");
+
 /* Helper to get current timestamp */
 static __always_inline __u64 get_timestamp(void)
 {
     return bpf_ktime_get_ns();
 }
 
+/* Read one tunable, falling back to its compile-time default while the
+ * slot is still zero (map not yet seeded by userspace) */
+static __always_inline __u64 config_get(__u32 key, __u64 fallback)
+{
+    __u64 *value = bpf_map_lookup_elem(&alopex_config, &key);
+
+    if (value && *value)
+        return *value;
+    return fallback;
+}
+
+/* Current detection window in nanoseconds */
+static __always_inline __u64 config_window_ns(void)
+{
+    return config_get(CFG_TIME_WINDOW_SEC, TIME_WINDOW_SEC) * 1000000000ULL;
+}
+
+/* Check a bit in the feature-disable mask */
+static __always_inline bool feature_disabled(__u64 bit)
+{
+    return config_get(CFG_FEATURE_DISABLE, 0) & bit;
+}
+
+/* Bump a per-CPU XDP statistic - no atomics needed, the slot is ours */
+static __always_inline void xdp_stat_inc(__u32 idx)
+{
+    __u64 *value = bpf_map_lookup_elem(&xdp_stats, &idx);
+    if (value)
+        *value += 1;
+}
+
 /* Helper to check if user is privileged */
 static __always_inline bool is_privileged_user(__u32 uid)
 {
@@ -96,35 +309,85 @@ static __always_inline bool is_suspicious_netlink_pattern(struct nlmsghdr *nlh)
         return true;  /* Suspicious link creation */
     }
     
-    /* Check for rapid-fire netlink messages */
+    /* Check for rapid-fire netlink messages (local CPU slot only -
+     * cross-CPU aggregation happens in userspace) */
     __u32 uid = bpf_get_current_uid_gid() & 0xFFFFFFFF;
-    __u32 *count = bpf_map_lookup_elem(&netlink_rate_limit, &uid);
-    if (count) {
-        if (*count > ALERT_THRESHOLD_NETLINK) {
-            return true;  /* Rate limit exceeded */
+    __u64 now = get_timestamp();
+    struct alopex_rate_entry *entry = bpf_map_lookup_elem(&netlink_rate_limit, &uid);
+    if (entry) {
+        /* Expire stale windows in place - no cleanup pass needed */
+        if (now - entry->window_start > config_window_ns()) {
+            entry->window_start = now;
+            entry->count = 1;
+            return false;
         }
-        *count += 1;
+        if (entry->count > config_get(CFG_NETLINK_THRESHOLD,
+                                      ALERT_THRESHOLD_NETLINK)) {
+            return true;  /* Rate limit exceeded on this CPU alone */
+        }
+        entry->count += 1;
     } else {
-        __u32 new_count = 1;
-        bpf_map_update_elem(&netlink_rate_limit, &uid, &new_count, BPF_NOEXIST);
+        struct alopex_rate_entry new_entry = {
+            .window_start = now,
+            .count = 1,
+        };
+        bpf_map_update_elem(&netlink_rate_limit, &uid, &new_entry, BPF_NOEXIST);
     }
-    
+
     return false;
 }
 
-/* Helper to send security alert */
-static __always_inline void send_security_alert(struct alopex_security_event *event)
+/* Raw ringbuf emission - only reached after the dedup stage */
+static __always_inline void emit_security_alert(struct alopex_security_event *event)
 {
     struct alopex_security_event *alert;
-    
+
     alert = bpf_ringbuf_reserve(&security_alerts, sizeof(*alert), 0);
     if (!alert)
         return;
-    
+
     __builtin_memcpy(alert, event, sizeof(*alert));
     bpf_ringbuf_submit(alert, 0);
 }
 
+/* Helper to send security alert, deduplicated per (type, src, pid).
+ * The first occurrence in a TIME_WINDOW_SEC window is emitted with
+ * count=1; repeats within the window only increment the dedup counter.
+ * When the window rolls over, the next occurrence carries the number of
+ * events suppressed since the last emission in its count field. */
+static __always_inline void send_security_alert(struct alopex_security_event *event)
+{
+    struct alopex_alert_key key = {
+        .event_type = event->event_type,
+        .src_ip = event->src_ip,
+        .pid = event->pid,
+    };
+    __u64 now = event->timestamp;
+
+    struct alopex_rate_entry *entry = bpf_map_lookup_elem(&alert_dedup, &key);
+    if (entry) {
+        if (now - entry->window_start <= config_window_ns()) {
+            /* Duplicate within window - count it, skip the ringbuf */
+            __sync_fetch_and_add(&entry->count, 1);
+            return;
+        }
+        /* Window rolled over - emit a summary of the suppressed events */
+        event->count = entry->count + 1;
+        entry->window_start = now;
+        entry->count = 0;
+        emit_security_alert(event);
+        return;
+    }
+
+    struct alopex_rate_entry new_entry = {
+        .window_start = now,
+        .count = 0,
+    };
+    bpf_map_update_elem(&alert_dedup, &key, &new_entry, BPF_NOEXIST);
+    event->count = 1;
+    emit_security_alert(event);
+}
+
 /* 
  * LSM Hook: Monitor privilege escalation attempts
  * Triggers on commit_creds() kernel function
@@ -204,70 +467,162 @@ int alopex_monitor_netlink(struct trace_event_raw_netlink_extack *ctx)
     return 0;
 }
 
-/*
- * XDP Program: Network packet filtering
- * Drops malicious network packets at kernel level
- */
-SEC("xdp")
-int alopex_network_filter(struct xdp_md *ctx)
+/* Shared header parsing for the XDP stages. Tail-called programs only
+ * receive the context, so each stage revalidates from ctx. */
+static __always_inline struct iphdr *parse_ipv4(struct xdp_md *ctx)
 {
     void *data_end = (void *)(long)ctx->data_end;
     void *data = (void *)(long)ctx->data;
-    
+
     struct ethhdr *eth = data;
     if ((void *)eth + sizeof(*eth) > data_end)
-        return XDP_PASS;
-    
+        return NULL;
+
     /* Only process IP packets */
     if (eth->h_proto != __builtin_bswap16(ETH_P_IP))
-        return XDP_PASS;
-    
+        return NULL;
+
     struct iphdr *ip = (void *)eth + sizeof(*eth);
     if ((void *)ip + sizeof(*ip) > data_end)
+        return NULL;
+
+    return ip;
+}
+
+/*
+ * XDP pipeline stage 1: TCP port-scan detection
+ * Reached via tail call from alopex_network_filter()
+ */
+SEC("xdp")
+int alopex_xdp_scan_detect(struct xdp_md *ctx)
+{
+    void *data_end = (void *)(long)ctx->data_end;
+
+    struct iphdr *ip = parse_ipv4(ctx);
+    if (!ip)
         return XDP_PASS;
-    
-    /* Check for suspicious network patterns */
-    
-    /* 1. Block packets with suspicious source IPs */
-    __u32 src_ip = __builtin_bswap32(ip->saddr);
-    if ((src_ip & 0xFF000000) == 0x0A000000 ||  /* 10.x.x.x private */
-        (src_ip & 0xFFFF0000) == 0xAC100000 ||  /* 172.16.x.x private */
-        (src_ip & 0xFFFF0000) == 0xC0A80000) {  /* 192.168.x.x private */
-        
-        /* Log suspicious private IP in public interface */
-        struct alopex_security_event event = {0};
-        event.timestamp = get_timestamp();
-        event.event_type = ALOPEX_EVENT_SUSPICIOUS_NETWORK;
-        event.severity = 2;
-        
-        send_security_alert(&event);
-    }
-    
-    /* 2. Monitor TCP packets for port scanning */
-    if (ip->protocol == IPPROTO_TCP) {
+
+    /* Monitor TCP packets for port scanning */
+    if (ip->protocol == IPPROTO_TCP &&
+        !feature_disabled(ALOPEX_FEATURE_SCAN_DETECT)) {
         struct tcphdr *tcp = (void *)ip + sizeof(*ip);
         if ((void *)tcp + sizeof(*tcp) > data_end)
             return XDP_PASS;
-            
-        __u16 dest_port = __builtin_bswap16(tcp->dest);
-        
-        /* Flag attempts to connect to sensitive ports */
-        if (dest_port == 22 || dest_port == 80 || dest_port == 443 || 
-            dest_port == 3389 || dest_port == 5432) {
-            
-            /* Rate limit connection attempts */
-            /* This is a simplified check - production would be more sophisticated */
-            if (tcp->syn && !tcp->ack) {  /* SYN packet */
-                struct alopex_security_event event = {0};
-                event.timestamp = get_timestamp();
-                event.event_type = ALOPEX_EVENT_SUSPICIOUS_NETWORK;
-                event.severity = 1;
-                
-                send_security_alert(&event);
+
+        if (tcp->syn && !tcp->ack) {  /* SYN packet */
+            xdp_stat_inc(STAT_SYN_PACKETS);
+
+            __u16 dest_port = __builtin_bswap16(tcp->dest);
+            __u64 now = get_timestamp();
+            __u32 src = ip->saddr;
+
+            /* Two bloom bits per port - Knuth multiplicative hash for
+             * the second so adjacent ports do not collide trivially */
+            __u64 bits = (1ULL << (dest_port & 63)) |
+                         (1ULL << ((dest_port * 2654435761U) >> 26 & 63));
+
+            struct alopex_scan_entry *entry =
+                bpf_map_lookup_elem(&scan_tracking, &src);
+            if (!entry) {
+                struct alopex_scan_entry new_entry = {
+                    .window_start = now,
+                    .port_bloom = bits,
+                    .distinct_ports = 1,
+                };
+                bpf_map_update_elem(&scan_tracking, &src, &new_entry, BPF_NOEXIST);
+            } else if (now - entry->window_start > config_window_ns()) {
+                /* Window rolled over - start fresh in place */
+                entry->window_start = now;
+                entry->port_bloom = bits;
+                entry->distinct_ports = 1;
+                entry->alerted = 0;
+            } else {
+                if ((entry->port_bloom & bits) != bits) {
+                    /* At least one new bit: probably a new port */
+                    entry->port_bloom |= bits;
+                    entry->distinct_ports += 1;
+                }
+
+                /* Armed evidence capture: redirect a 1-in-N sample of
+                 * traffic from already-flagged sources to the AF_XDP
+                 * capture socket for this RX queue */
+                __u64 sample_n = config_get(CFG_CAPTURE_SAMPLE_N, 0);
+                if (sample_n && entry->alerted &&
+                    bpf_get_prandom_u32() % sample_n == 0) {
+                    xdp_stat_inc(STAT_PACKETS_CAPTURED);
+                    return bpf_redirect_map(&capture_socks,
+                                            ctx->rx_queue_index, XDP_PASS);
+                }
+
+                if (entry->distinct_ports > config_get(CFG_PORTSCAN_THRESHOLD,
+                                                       ALERT_THRESHOLD_PORTSCAN) &&
+                    !entry->alerted) {
+                    /* One alert per source per window, carrying the
+                     * distinct-port estimate instead of one event per SYN */
+                    entry->alerted = 1;
+
+                    struct alopex_security_event event = {0};
+                    event.timestamp = now;
+                    event.event_type = ALOPEX_EVENT_SUSPICIOUS_NETWORK;
+                    event.severity = config_get(CFG_SEVERITY_PORTSCAN,
+                                                SEVERITY_PORTSCAN);
+                    event.src_ip = src;
+                    event.count = entry->distinct_ports;
+
+                    emit_security_alert(&event);
+                }
             }
         }
     }
-    
+
+    xdp_stat_inc(STAT_PACKETS_PASSED);
+    return XDP_PASS;
+}
+
+/*
+ * XDP pipeline entry: parsing, counters and blocklist enforcement
+ * Drops malicious network packets at kernel level, then tail-calls
+ * into the detection stages
+ */
+SEC("xdp")
+int alopex_network_filter(struct xdp_md *ctx)
+{
+    struct iphdr *ip = parse_ipv4(ctx);
+    if (!ip)
+        return XDP_PASS;
+
+    xdp_stat_inc(STAT_PACKETS_SEEN);
+
+    /* Drop packets from blocklisted source networks at the driver
+     * level - longest-prefix match against the runtime-managed trie */
+    if (!feature_disabled(ALOPEX_FEATURE_BLOCKLIST)) {
+        struct alopex_lpm_key lpm_key = {
+            .prefixlen = 32,
+            .addr = ip->saddr,
+        };
+        __u8 *verdict = bpf_map_lookup_elem(&blocked_networks, &lpm_key);
+        if (verdict && *verdict == ALOPEX_VERDICT_BLOCK) {
+            xdp_stat_inc(STAT_BLOCKLIST_HITS);
+            xdp_stat_inc(STAT_PACKETS_DROPPED);
+
+            struct alopex_security_event event = {0};
+            event.timestamp = get_timestamp();
+            event.event_type = ALOPEX_EVENT_SUSPICIOUS_NETWORK;
+            event.severity = config_get(CFG_SEVERITY_BLOCKLIST,
+                                        SEVERITY_BLOCKLIST);
+            event.src_ip = ip->saddr;
+
+            send_security_alert(&event);
+            return XDP_DROP;
+        }
+    }
+
+    /* Hand off to the detection stage; does not return on success */
+    bpf_tail_call(ctx, &xdp_pipeline, XDP_PROG_SCAN_DETECT);
+
+    /* Slot not populated - fail open */
+    xdp_stat_inc(STAT_TAIL_CALL_MISSES);
+    xdp_stat_inc(STAT_PACKETS_PASSED);
     return XDP_PASS;
 }
 
@@ -325,20 +680,13 @@ int alopex_monitor_netns_changes(struct bpf_iter__ns_common *ctx)
 }
 
 /*
- * Map cleanup function - called periodically
- * Removes old entries to prevent memory leaks
+ * Map cleanup: capacity pressure is handled by the LRU map types above
+ * (the kernel evicts least-recently-used entries on insert), and rate
+ * entries expire in place when their window timestamp goes stale.
+ * Entries that are never touched again are reclaimed by the batched
+ * userspace sweep in security.py (EBPFNetworkMonitor.sweep_expired_entries),
+ * which compares embedded timestamps against TIME_WINDOW_SEC.
  */
-SEC("tp/timer/timer_expire_exit")
-int alopex_cleanup_maps(struct trace_event_raw_timer_class *ctx)
-{
-    __u64 now = get_timestamp();
-    __u64 cutoff = now - (TIME_WINDOW_SEC * 1000000000ULL);
-    
-    /* This is a simplified cleanup - production would iterate through maps */
-    /* Cleanup would be handled by userspace control program */
-    
-    return 0;
-}
 
 /* License required for eBPF programs */
 char _license[] SEC("license") = "GPL";
@@ -12,6 +12,7 @@ import logging
 import asyncio
 import subprocess
 from pathlib import Path
+from types import SimpleNamespace
 from typing import List, Dict, Optional, Tuple
 from enum import Enum
 
@@ -22,6 +23,9 @@ SHIM_VERSION = "0.1.0"
 # Deterministic UUID namespace for connection compatibility
 UUID_NAMESPACE = uuid.UUID("12345678-0000-4321-abcd-000000000000")
 
+# Control socket exposed by the resident daemon
+CONTROL_SOCKET_PATH = "/run/alopex/alopexd.sock"
+
 # Configure logging
 logging.basicConfig(level=logging.INFO, format="%(asctime)s [%(levelname)s] nmcli-compat: %(message)s")
 logger = logging.getLogger(__name__)
@@ -34,11 +38,11 @@ class LinkState(Enum):
     UNAVAILABLE = "unavailable"
     UNMANAGED = "unmanaged"
 
-def _configure_sys_path():
-    """Configure Python path for ALOPEX modules with proper fallbacks"""
+def _module_search_paths() -> List[Path]:
+    """Candidate locations of the ALOPEX module tree, in priority order"""
     dev_path = Path(__file__).parent.parent / "alopex-qt"
     env_path = os.getenv("ALOPEX_PYTHON_PATH")
-    
+
     candidates = []
     if env_path:
         candidates.append(Path(env_path))
@@ -47,7 +51,11 @@ def _configure_sys_path():
         Path("/usr/local/lib/alopex"),
         dev_path
     ])
-    
+    return candidates
+
+def _configure_sys_path():
+    """Configure Python path for ALOPEX modules with proper fallbacks"""
+    candidates = _module_search_paths()
     for p in candidates:
         if p.exists() and (p / "network").exists():
             sys.path.insert(0, str(p))
@@ -59,18 +67,55 @@ def _configure_sys_path():
     print("Install ALOPEX or set ALOPEX_PYTHON_PATH environment variable", file=sys.stderr)
     sys.exit(1)
 
-_configure_sys_path()
-
-try:
-    from network.discovery import NetworkDiscovery
-    from network.system_integration import NetworkControl
-    from network.wifi import WiFiManager
-    from network.connection_manager import ConnectionManager
-except ImportError as e:
-    logger.exception("Failed to import ALOPEX core modules")
-    print(f"ALOPEX nmcli shim: failed to import core modules: {e}", file=sys.stderr)
-    print("Ensure ALOPEX is properly installed", file=sys.stderr)
-    sys.exit(1)
+_local_backend = None
+
+def _load_local_backend():
+    """Import the ALOPEX core modules for standalone operation.
+
+    Deferred until the daemon socket turns out to be unavailable, so the
+    common path (daemon running) never pays for these imports.
+    """
+    global _local_backend
+    if _local_backend is not None:
+        return _local_backend
+
+    _configure_sys_path()
+    try:
+        from network.discovery import NetworkDiscovery
+        from network.system_integration import NetworkControl
+        from network.wifi import WiFiManager
+        from network.connection_manager import ConnectionManager
+    except ImportError as e:
+        logger.exception("Failed to import ALOPEX core modules")
+        print(f"ALOPEX nmcli shim: failed to import core modules: {e}", file=sys.stderr)
+        print("Ensure ALOPEX is properly installed", file=sys.stderr)
+        sys.exit(1)
+
+    _local_backend = (NetworkDiscovery, NetworkControl, WiFiManager, ConnectionManager)
+    return _local_backend
+
+def _load_daemon_client():
+    """Load the shared AlopexDaemonClient class, or None if not installed.
+
+    The module file is loaded directly rather than through the network
+    package so the shim never triggers the package __init__ and its
+    heavy module imports - the client itself is stdlib-only.
+    """
+    import importlib.util
+
+    for p in _module_search_paths():
+        client_path = p / "network" / "daemon_client.py"
+        if not client_path.exists():
+            continue
+        try:
+            spec = importlib.util.spec_from_file_location(
+                "alopex_daemon_client", client_path)
+            module = importlib.util.module_from_spec(spec)
+            spec.loader.exec_module(module)
+            return module.AlopexDaemonClient
+        except Exception as e:
+            logger.debug(f"Failed to load daemon client from {client_path}: {e}")
+    return None
 
 def deterministic_uuid_for_name(name: str) -> str:
     """Generate deterministic UUID for connection name (fixes hash() randomization)"""
@@ -110,17 +155,66 @@ class NmcliCompat:
     """TITANIUM-grade NetworkManager CLI compatibility layer"""
     
     def __init__(self):
-        self.discovery = NetworkDiscovery()
-        self.control = NetworkControl()
-        self.wifi = WiFiManager()
-        self.conn_mgr = ConnectionManager()
         self.quiet = os.getenv("ALOPEX_NMCLI_QUIET") is not None
         self.debug = os.getenv("ALOPEX_DEBUG") is not None
-    
+
+        # Prefer the resident daemon; only import and instantiate the
+        # full backend when it is not running
+        client_cls = _load_daemon_client()
+        self.daemon = client_cls(CONTROL_SOCKET_PATH) if client_cls else None
+        if self.daemon and self.daemon.connect():
+            logger.debug("Using alopexd control socket")
+            self.discovery = None
+            self.control = None
+            self.wifi = None
+            self.conn_mgr = None
+        else:
+            self.daemon = None
+            NetworkDiscovery, NetworkControl, WiFiManager, ConnectionManager = _load_local_backend()
+            self.discovery = NetworkDiscovery()
+            self.control = NetworkControl()
+            self.wifi = WiFiManager()
+            self.conn_mgr = ConnectionManager()
+
+    # BACKEND HELPERS - daemon round-trip with local fallback
+    def _get_interfaces(self):
+        """List interfaces via the daemon or local discovery"""
+        if self.daemon:
+            return [SimpleNamespace(**iface) for iface in self.daemon.request("interfaces")]
+        return self.discovery.discover_interfaces()
+
+    def _get_profiles(self):
+        """Fetch connection profiles keyed by name"""
+        if self.daemon:
+            return {name: SimpleNamespace(**profile)
+                    for name, profile in self.daemon.request("profiles").items()}
+        return self.conn_mgr.profiles
+
+    def _scan_wifi(self, device: str):
+        """Scan WiFi networks on a device"""
+        if self.daemon:
+            return [SimpleNamespace(**net) for net in self.daemon.request("wifi_scan", device=device)]
+        return self.wifi.scan_networks(device)
+
+    def _connect_profile(self, name: str) -> bool:
+        if self.daemon:
+            return bool(self.daemon.request("connect_profile", name=name))
+        return asyncio.run(self.conn_mgr.connect_profile(name))
+
+    def _disconnect_interface(self, interface: str) -> bool:
+        if self.daemon:
+            return bool(self.daemon.request("disconnect_interface", interface=interface))
+        return asyncio.run(self.conn_mgr.disconnect_interface(interface))
+
+    def _auto_connect_interface(self, interface: str) -> bool:
+        if self.daemon:
+            return bool(self.daemon.request("auto_connect_interface", interface=interface))
+        return asyncio.run(self.conn_mgr.auto_connect_interface(interface))
+
     def device_status(self, args) -> int:
         """nmcli device status"""
         try:
-            interfaces = self.discovery.discover_interfaces()
+            interfaces = self._get_interfaces()
         except Exception as e:
             logger.exception("Failed to discover interfaces")
             if not self.quiet:
@@ -152,7 +246,7 @@ class NmcliCompat:
         if not device:
             # Find first WiFi device
             try:
-                interfaces = self.discovery.discover_interfaces()
+                interfaces = self._get_interfaces()
                 wifi_interfaces = [i for i in interfaces if i.interface_type.lower() == "wifi"]
                 if not wifi_interfaces:
                     if not self.quiet:
@@ -167,7 +261,7 @@ class NmcliCompat:
         
         try:
             # Use real ALOPEX WiFi scanning
-            networks = self.wifi.scan_networks(device)
+            networks = self._scan_wifi(device)
             
             if args.get('terse', False):
                 # Terse format: SSID:MODE:CHAN:RATE:SIGNAL:BARS:SECURITY
@@ -209,8 +303,8 @@ class NmcliCompat:
             return 2
         
         try:
-            # Use real ALOPEX connection management via asyncio
-            success = asyncio.run(self._async_connect_device(device))
+            # Use real ALOPEX connection management
+            success = self._connect_device(device)
             msg = f"Device {device} connected successfully" if success else f"Failed to connect {device}"
             if success:
                 if not args.get('quiet', False):
@@ -230,7 +324,7 @@ class NmcliCompat:
         """nmcli connection show"""
         try:
             # Use real ALOPEX connection management
-            profiles = self.conn_mgr.get_profiles()
+            profiles = self._get_profiles()
             connections = [(p.name, p.connection_type, p.interface) for p in profiles.values()]
             
             if args.get('terse', False):
@@ -269,8 +363,8 @@ class NmcliCompat:
             return 2
         
         try:
-            # Use real ALOPEX connection management via asyncio
-            success = asyncio.run(self.conn_mgr.connect_profile(conn_name))
+            # Use real ALOPEX connection management
+            success = self._connect_profile(conn_name)
             msg = f"Connection {conn_name} activated successfully" if success else f"Failed to activate {conn_name}"
             if success:
                 if not args.get('quiet', False):
@@ -295,12 +389,11 @@ class NmcliCompat:
             return 2
         
         try:
-            # Use real ALOPEX connection management via asyncio  
             # Find the profile to get interface name for disconnection
-            profiles = self.conn_mgr.get_profiles()
+            profiles = self._get_profiles()
             if conn_name in profiles:
                 interface = profiles[conn_name].interface
-                success = asyncio.run(self.conn_mgr.disconnect_interface(interface))
+                success = self._disconnect_interface(interface)
                 msg = f"Connection {conn_name} deactivated successfully" if success else f"Failed to deactivate {conn_name}"
             else:
                 success = False
@@ -322,7 +415,7 @@ class NmcliCompat:
     def general_status(self, args) -> int:
         """nmcli general status"""
         try:
-            interfaces = self.discovery.list_interfaces()
+            interfaces = self._get_interfaces()
             connected_count = len([i for i in interfaces if _map_interface_state(i.status) == "connected"])
             
             if args.get('terse', False):
@@ -382,7 +475,7 @@ class NmcliCompat:
                     return 1
             else:
                 # Query current state by checking if WiFi interfaces exist
-                enabled = len(self.wifi.get_wifi_interfaces()) > 0
+                enabled = len(self._get_wifi_interface_names()) > 0
                 if args.get('terse', False):
                     print("enabled" if enabled else "disabled")
                 else:
@@ -452,26 +545,30 @@ class NmcliCompat:
             pass
         return "1"  # Default channel
     
-    async def _async_connect_device(self, device: str) -> bool:
-        """Async device connection helper"""
+    def _connect_device(self, device: str) -> bool:
+        """Device connection helper"""
         try:
             # Find profile for this device and connect
-            profiles = self.conn_mgr.get_profiles()
+            profiles = self._get_profiles()
             device_profiles = [p for p in profiles.values() if p.interface == device]
             if device_profiles:
                 # Use first available profile for this device
-                return await self.conn_mgr.connect_profile(device_profiles[0].name)
+                return self._connect_profile(device_profiles[0].name)
             else:
                 # Try auto-connecting the interface
-                return await self.conn_mgr.auto_connect_interface(device)
+                return self._auto_connect_interface(device)
         except Exception as e:
-            logger.exception(f"Async device connect failed for {device}")
+            logger.exception(f"Device connect failed for {device}")
             return False
-    
+
+    def _get_wifi_interface_names(self) -> List[str]:
+        """Names of WiFi-capable interfaces"""
+        return [i.name for i in self._get_interfaces() if i.interface_type.lower() == "wifi"]
+
     def _enable_wifi_interfaces(self) -> bool:
         """Enable WiFi interfaces using ip commands"""
         try:
-            wifi_ifaces = self.wifi.get_wifi_interfaces()
+            wifi_ifaces = self._get_wifi_interface_names()
             for iface in wifi_ifaces:
                 subprocess.run(['sudo', 'ip', 'link', 'set', iface, 'up'], check=True)
             return True
@@ -482,7 +579,7 @@ class NmcliCompat:
     def _disable_wifi_interfaces(self) -> bool:
         """Disable WiFi interfaces using ip commands"""
         try:
-            wifi_ifaces = self.wifi.get_wifi_interfaces()
+            wifi_ifaces = self._get_wifi_interface_names()
             for iface in wifi_ifaces:
                 subprocess.run(['sudo', 'ip', 'link', 'set', iface, 'down'], check=True)
             return True
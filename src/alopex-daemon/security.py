@@ -102,13 +102,23 @@ class CapabilityManager:
 
 class SecureNetlinkSocket:
     """Hardened netlink socket implementation"""
-    
+
+    # Netlink message header: length, type, flags, sequence, pid
+    NLMSG_HEADER = struct.Struct("IHHII")
+
+    # Preallocated receive buffer for the batched path - large enough to
+    # pull many packed netlink messages out of the kernel per recv
+    RECV_BUFFER_SIZE = 262144
+
     def __init__(self, security_ctx: SecurityContext):
         self.security_ctx = security_ctx
         self.socket = None
         self.message_counter = 0
         self.session_key = secrets.token_bytes(32)
-        
+        self._epoll = None
+        self._recv_buffer = None
+        self._recv_view = None
+
     def create_socket(self, netlink_family: int) -> bool:
         """Create hardened netlink socket with validation"""
         try:
@@ -151,37 +161,96 @@ class SecureNetlinkSocket:
             return False
     
     def receive_validated_message(self, timeout: float = 5.0) -> Optional[Tuple[int, bytes]]:
-        """Receive and validate netlink message"""
+        """Receive and validate a single netlink message"""
         if not self.socket:
             return None
-            
+
         try:
             # Set timeout
             self.socket.settimeout(timeout)
-            
+
             # Receive message
             data, addr = self.socket.recvfrom(65536)
-            
-            # Validate message integrity
-            if not self._validate_message(data):
+
+            # Validate and parse (first message of the datagram)
+            messages = self._validate_message_batch(data, len(data))
+            if not messages:
                 logger.warning("Received invalid netlink message - potential attack")
                 return None
-            
-            # Parse and return
-            msg_type, payload = self._parse_message(data)
-            
+
+            msg_type, payload = messages[0]
+
             if self.security_ctx.audit_enabled:
                 self._audit_log("NETLINK_RECV", msg_type, len(payload))
-            
+
             return msg_type, payload
-            
+
         except socket.timeout:
             logger.debug("Netlink receive timeout")
             return None
         except Exception as e:
             logger.error(f"Failed to receive netlink message: {e}")
             return None
-    
+
+    def enable_event_driven(self) -> bool:
+        """Switch to the nonblocking epoll-driven receive path.
+
+        The socket stops blocking per message: an epoll instance owns the
+        fd, a preallocated buffer takes many packed netlink messages per
+        recv_into(), and validation walks each buffer in one pass. This
+        is the mode the event-driven monitor uses to drain notification
+        bursts without one syscall and one validation call per message.
+        """
+        if not self.socket:
+            return False
+
+        try:
+            import select
+            self.socket.setblocking(False)
+            # Deep kernel-side queue so bursts survive scheduling gaps
+            self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 1 << 20)
+            self._recv_buffer = bytearray(self.RECV_BUFFER_SIZE)
+            self._recv_view = memoryview(self._recv_buffer)
+            self._epoll = select.epoll()
+            self._epoll.register(self.socket.fileno(), select.EPOLLIN)
+            logger.info("Netlink socket switched to event-driven receive")
+            return True
+        except Exception as e:
+            logger.error(f"Failed to enable event-driven receive: {e}")
+            return False
+
+    def receive_message_batch(self, timeout: float = 1.0) -> List[Tuple[int, bytes]]:
+        """Drain all pending netlink messages in a few syscalls.
+
+        Waits up to `timeout` seconds for readability, then loops
+        recv_into() until the kernel queue is empty, validating every
+        message in each buffer in a single pass. Returns the whole burst
+        at once; an empty list means the wait timed out.
+        """
+        if not self._epoll:
+            raise RuntimeError("enable_event_driven() not called")
+
+        messages: List[Tuple[int, bytes]] = []
+        if not self._epoll.poll(timeout):
+            return messages
+
+        while True:
+            try:
+                received = self.socket.recv_into(self._recv_buffer)
+            except BlockingIOError:
+                break
+            except Exception as e:
+                logger.error(f"Netlink batch receive failed: {e}")
+                break
+            if received == 0:
+                break
+            messages.extend(self._validate_message_batch(self._recv_view, received))
+
+        if messages and self.security_ctx.audit_enabled:
+            self._audit_log("NETLINK_RECV_BATCH", messages[0][0], len(messages))
+
+        return messages
+
     def _create_validated_message(self, msg_type: int, data: bytes) -> bytes:
         """Create netlink message with cryptographic validation"""
         # Netlink header: length, type, flags, sequence, pid
@@ -201,39 +270,55 @@ class SecureNetlinkSocket:
         self.message_counter += 1
         return header + data + mac
     
-    def _validate_message(self, data: bytes) -> bool:
-        """Validate incoming netlink message"""
-        if len(data) < 48:  # minimum size with HMAC
-            return False
-            
+    def _validate_message_batch(self, data, available: int) -> List[Tuple[int, bytes]]:
+        """Validate and parse every netlink message in a buffer in one pass.
+
+        The kernel packs multiple netlink messages per datagram; each is
+        walked by its own header length (NLMSG_ALIGN'd), validated once,
+        and returned as (msg_type, payload). Kernel-originated messages
+        (pid 0) carry no HMAC; userspace messages must carry our trailing
+        HMAC or they are dropped and logged.
+        """
+        messages: List[Tuple[int, bytes]] = []
+        view = memoryview(data)
+        offset = 0
+
+        while offset + self.NLMSG_HEADER.size <= available:
+            try:
+                length, msg_type, flags, sequence, pid = \
+                    self.NLMSG_HEADER.unpack_from(view, offset)
+            except struct.error:
+                break
+
+            # Length must cover at least the header and fit the buffer
+            if length < self.NLMSG_HEADER.size or offset + length > available:
+                logger.warning("Malformed netlink message length - dropping rest of buffer")
+                break
+
+            if pid == 0:
+                # Kernel messages carry no HMAC
+                messages.append((msg_type, bytes(view[offset + 16:offset + length])))
+            elif length >= 48 and self._check_hmac(view[offset:offset + length]):
+                # Userspace message with our trailing HMAC
+                messages.append((msg_type, bytes(view[offset + 16:offset + length - 32])))
+            else:
+                logger.warning("Received invalid netlink message - potential attack")
+
+            # NLMSG_ALIGN: messages are padded to 4-byte boundaries
+            offset += (length + 3) & ~3
+
+        return messages
+
+    def _check_hmac(self, message_view) -> bool:
+        """Verify the trailing HMAC of one userspace message"""
         try:
-            # Parse header
-            length, msg_type, flags, sequence, pid = struct.unpack("IHHII", data[:16])
-            
-            # Validate basic constraints
-            if length != len(data):
-                return False
-            if pid == 0:  # kernel messages
-                return True
-                
-            # Validate HMAC if present
-            message = data[:-32]
-            received_mac = data[-32:]
-            
             import hmac
-            expected_mac = hmac.new(self.session_key, message, hashlib.sha256).digest()
-            return hmac.compare_digest(received_mac, expected_mac)
-            
-        except:
+            expected_mac = hmac.new(
+                self.session_key, bytes(message_view[:-32]), hashlib.sha256).digest()
+            return hmac.compare_digest(bytes(message_view[-32:]), expected_mac)
+        except Exception:
             return False
-    
-    def _parse_message(self, data: bytes) -> Tuple[int, bytes]:
-        """Parse validated netlink message"""
-        # Extract type and payload
-        msg_type = struct.unpack("IHHII", data[:16])[1]
-        payload = data[16:-32]  # exclude header and HMAC
-        return msg_type, payload
-    
+
     def _audit_log(self, operation: str, msg_type: int, size: int):
         """Security audit logging"""
         timestamp = time.time()
@@ -250,13 +335,617 @@ class SecureNetlinkSocket:
         except:
             pass
 
+class SecurityAlertConsumer:
+    """High-throughput consumer for the security_alerts ring buffer.
+
+    Runs an epoll-driven reader thread that drains the kernel ring
+    buffer in batches through libbpf (via ctypes), decodes the
+    fixed-layout struct alopex_security_event records without per-event
+    allocation, and hands batches to a processing callback through a
+    bounded queue. The reader never blocks on processing: if the queue
+    fills during an incident storm, whole batches are dropped and
+    counted rather than stalling the drain loop.
+    """
+
+    # Layout of struct alopex_security_event in ebpf_monitor.c:
+    # pid, uid, gid, pad, timestamp, event_type, severity, comm[16],
+    # netlink_type, interface_index, suspicious_pattern[32], src_ip, count
+    EVENT_STRUCT = struct.Struct("<III4xQII16sII32sII")
+
+    BATCH_SIZE = 256        # events handed to the queue at once
+    QUEUE_DEPTH = 64        # bounded queue of batches (~16k events)
+
+    # Map kernel event types to the indicator keys detect_anomaly() uses
+    EVENT_INDICATORS = {
+        1: "unusual_netlink_patterns",      # ALOPEX_EVENT_NETLINK_ANOMALY
+        2: "privilege_escalation_attempt",  # ALOPEX_EVENT_PRIV_ESCALATION
+        3: "suspicious_network_pattern",    # ALOPEX_EVENT_SUSPICIOUS_NETWORK
+        4: "unauthorized_interface_access", # ALOPEX_EVENT_UNAUTHORIZED_INTERFACE
+        5: "malicious_pattern",             # ALOPEX_EVENT_MALICIOUS_PATTERN
+    }
+
+    def __init__(self, ringbuf_pin_path: str, process_event):
+        self.ringbuf_pin_path = ringbuf_pin_path
+        self.process_event = process_event
+        self.running = False
+        self.events_consumed = 0
+        self.batches_dropped = 0
+
+        self._libbpf = None
+        self._ring = None
+        self._ringbuf_fd = -1
+        self._reader_thread = None
+        self._worker_thread = None
+        self._batch = []
+        self._queue = None
+        self._sample_cb = None  # keep the ctypes callback referenced
+
+    def start(self) -> bool:
+        """Open the pinned ring buffer and start the reader/worker threads"""
+        import queue
+        import threading
+
+        try:
+            self._libbpf = self._load_libbpf()
+            if not self._libbpf:
+                logger.warning("libbpf unavailable - alert consumption disabled")
+                return False
+
+            self._ringbuf_fd = self._libbpf.bpf_obj_get(
+                self.ringbuf_pin_path.encode())
+            if self._ringbuf_fd < 0:
+                logger.warning(f"Cannot open pinned ringbuf: {self.ringbuf_pin_path}")
+                return False
+
+            sample_fn = ctypes.CFUNCTYPE(
+                ctypes.c_int, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t)
+            self._sample_cb = sample_fn(self._on_sample)
+            self._ring = self._libbpf.ring_buffer__new(
+                self._ringbuf_fd, self._sample_cb, None, None)
+            if not self._ring:
+                logger.error("ring_buffer__new failed")
+                return False
+
+            self._queue = queue.Queue(maxsize=self.QUEUE_DEPTH)
+            self.running = True
+
+            self._reader_thread = threading.Thread(
+                target=self._reader_loop, name="alopex-ringbuf", daemon=True)
+            self._worker_thread = threading.Thread(
+                target=self._worker_loop, name="alopex-alerts", daemon=True)
+            self._reader_thread.start()
+            self._worker_thread.start()
+
+            logger.info("Security alert consumer started")
+            return True
+
+        except Exception as e:
+            logger.error(f"Failed to start alert consumer: {e}")
+            return False
+
+    def stop(self):
+        """Stop consumption and release libbpf resources"""
+        self.running = False
+        if self._worker_thread:
+            self._queue.put(None)  # wake the worker
+            self._worker_thread.join(timeout=2)
+        if self._reader_thread:
+            self._reader_thread.join(timeout=2)
+        if self._ring and self._libbpf:
+            self._libbpf.ring_buffer__free(self._ring)
+            self._ring = None
+        if self._ringbuf_fd >= 0:
+            os.close(self._ringbuf_fd)
+            self._ringbuf_fd = -1
+
+    def _load_libbpf(self):
+        """Bind the small libbpf surface we need via ctypes"""
+        for soname in ("libbpf.so.1", "libbpf.so.0", "libbpf.so"):
+            try:
+                lib = ctypes.CDLL(soname)
+                break
+            except OSError:
+                continue
+        else:
+            return None
+
+        lib.bpf_obj_get.argtypes = [ctypes.c_char_p]
+        lib.bpf_obj_get.restype = ctypes.c_int
+        lib.ring_buffer__new.argtypes = [
+            ctypes.c_int, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+        lib.ring_buffer__new.restype = ctypes.c_void_p
+        lib.ring_buffer__epoll_fd.argtypes = [ctypes.c_void_p]
+        lib.ring_buffer__epoll_fd.restype = ctypes.c_int
+        lib.ring_buffer__consume.argtypes = [ctypes.c_void_p]
+        lib.ring_buffer__consume.restype = ctypes.c_int
+        lib.ring_buffer__free.argtypes = [ctypes.c_void_p]
+        lib.ring_buffer__free.restype = None
+        return lib
+
+    def _on_sample(self, ctx, data, size) -> int:
+        """libbpf per-record callback - decode and stage into the batch"""
+        if size < self.EVENT_STRUCT.size:
+            return 0
+
+        (pid, uid, gid, timestamp, event_type, severity, comm,
+         netlink_type, interface_index, pattern, src_ip, count) = \
+            self.EVENT_STRUCT.unpack(ctypes.string_at(data, self.EVENT_STRUCT.size))
+
+        self._batch.append({
+            "pid": pid,
+            "uid": uid,
+            "gid": gid,
+            "timestamp": timestamp,
+            "event_type": event_type,
+            "severity": severity,
+            "comm": comm.split(b"\x00", 1)[0].decode("ascii", "replace"),
+            "src_ip": src_ip,
+            "count": count,
+            self.EVENT_INDICATORS.get(event_type, "unknown_event"): True,
+        })
+        self.events_consumed += 1
+
+        if len(self._batch) >= self.BATCH_SIZE:
+            self._flush_batch()
+        return 0
+
+    def _flush_batch(self):
+        """Hand the staged batch to the worker without blocking the drain"""
+        if not self._batch:
+            return
+        import queue
+        try:
+            self._queue.put_nowait(self._batch)
+        except queue.Full:
+            self.batches_dropped += 1
+        self._batch = []
+
+    def _reader_loop(self):
+        """Epoll-driven drain loop - one wakeup consumes everything pending"""
+        import select
+
+        epoll_fd = self._libbpf.ring_buffer__epoll_fd(self._ring)
+        poller = select.epoll.fromfd(os.dup(epoll_fd))
+
+        while self.running:
+            try:
+                events = poller.poll(timeout=1.0)
+                if not events:
+                    continue
+                # Drain the buffer completely, then flush the tail batch
+                self._libbpf.ring_buffer__consume(self._ring)
+                self._flush_batch()
+            except Exception as e:
+                if self.running:
+                    logger.error(f"Ring buffer consumption error: {e}")
+                    time.sleep(0.1)
+
+        poller.close()
+
+    def _worker_loop(self):
+        """Process queued batches off the hot drain path"""
+        while self.running:
+            batch = self._queue.get()
+            if batch is None:
+                break
+            for event in batch:
+                try:
+                    self.process_event(event)
+                except Exception as e:
+                    logger.error(f"Alert processing error: {e}")
+
+class BPFMapExporter:
+    """Batched snapshot reader for pinned BPF maps.
+
+    Uses BPF_MAP_LOOKUP_BATCH (and the LOOKUP_AND_DELETE variant) via
+    libbpf so an entire 4096-entry tracking map comes back in a handful
+    of bpf(2) syscalls instead of one lookup per key. Per-CPU maps
+    return one value block per possible CPU; callers sum the blocks.
+    This is what makes kernel-side state observable at 1 Hz for
+    microseconds of CPU rather than milliseconds.
+    """
+
+    # Keys pulled per bpf(2) syscall
+    BATCH_KEYS = 256
+
+    # Key/value sizes of the exported maps - must match ebpf_monitor.c
+    MAP_LAYOUTS = {
+        "privilege_tracking": {"key_size": 4, "value_size": 8, "percpu": False},
+        "netlink_rate_limit": {"key_size": 4, "value_size": 16, "percpu": True},
+        "scan_tracking": {"key_size": 4, "value_size": 24, "percpu": False},
+        "xdp_stats": {"key_size": 4, "value_size": 8, "percpu": True},
+    }
+
+    def __init__(self, pin_dir: str):
+        self.pin_dir = pin_dir
+        self._fds: Dict[str, int] = {}
+        self._libbpf = self._load_libbpf()
+        self._num_cpus = self._possible_cpus()
+
+    def available(self) -> bool:
+        return self._libbpf is not None
+
+    def close(self):
+        """Release cached map fds"""
+        for fd in self._fds.values():
+            os.close(fd)
+        self._fds = {}
+
+    def snapshot_map(self, map_name: str, consume: bool = False) -> List[Tuple[bytes, bytes]]:
+        """Snapshot one pinned map as (key, value) byte pairs.
+
+        With consume=True the LOOKUP_AND_DELETE batch variant is used,
+        draining the map in the same syscalls that read it. Per-CPU map
+        values are the concatenated per-CPU blocks.
+        """
+        layout = self.MAP_LAYOUTS.get(map_name)
+        if not layout or not self._libbpf:
+            return []
+
+        fd = self._map_fd(map_name)
+        if fd < 0:
+            return []
+
+        key_size = layout["key_size"]
+        value_size = layout["value_size"]
+        if layout["percpu"]:
+            # Kernel hands back one 8-byte-aligned block per possible CPU
+            value_size = ((value_size + 7) & ~7) * self._num_cpus
+
+        lookup = (self._libbpf.bpf_map_lookup_and_delete_batch
+                  if consume else self._libbpf.bpf_map_lookup_batch)
+
+        keys_buf = ctypes.create_string_buffer(key_size * self.BATCH_KEYS)
+        values_buf = ctypes.create_string_buffer(value_size * self.BATCH_KEYS)
+        batch_token = ctypes.create_string_buffer(8)
+        in_batch = None  # NULL on the first call starts from the beginning
+
+        entries: List[Tuple[bytes, bytes]] = []
+        while True:
+            count = ctypes.c_uint(self.BATCH_KEYS)
+            ret = lookup(fd, in_batch, batch_token,
+                         keys_buf, values_buf, ctypes.byref(count), None)
+
+            for i in range(count.value):
+                entries.append((
+                    keys_buf.raw[i * key_size:(i + 1) * key_size],
+                    values_buf.raw[i * value_size:(i + 1) * value_size]))
+
+            if ret != 0:
+                # -ENOENT marks the final (possibly partial) batch
+                if ret != -2:
+                    logger.debug(f"Batch lookup on {map_name} ended: {ret}")
+                break
+            in_batch = batch_token
+
+        return entries
+
+    def _map_fd(self, map_name: str) -> int:
+        """Open (and cache) the pinned map fd"""
+        fd = self._fds.get(map_name)
+        if fd is not None:
+            return fd
+
+        fd = self._libbpf.bpf_obj_get(f"{self.pin_dir}/{map_name}".encode())
+        if fd < 0:
+            logger.debug(f"Cannot open pinned map: {map_name}")
+            return -1
+        self._fds[map_name] = fd
+        return fd
+
+    def _possible_cpus(self) -> int:
+        if self._libbpf:
+            cpus = self._libbpf.libbpf_num_possible_cpus()
+            if cpus > 0:
+                return cpus
+        return os.cpu_count() or 1
+
+    def _load_libbpf(self):
+        """Bind the batch-lookup libbpf surface via ctypes"""
+        for soname in ("libbpf.so.1", "libbpf.so.0", "libbpf.so"):
+            try:
+                lib = ctypes.CDLL(soname)
+                break
+            except OSError:
+                continue
+        else:
+            return None
+
+        lib.bpf_obj_get.argtypes = [ctypes.c_char_p]
+        lib.bpf_obj_get.restype = ctypes.c_int
+        batch_args = [ctypes.c_int, ctypes.c_void_p, ctypes.c_void_p,
+                      ctypes.c_void_p, ctypes.c_void_p,
+                      ctypes.POINTER(ctypes.c_uint), ctypes.c_void_p]
+        lib.bpf_map_lookup_batch.argtypes = batch_args
+        lib.bpf_map_lookup_batch.restype = ctypes.c_int
+        lib.bpf_map_lookup_and_delete_batch.argtypes = batch_args
+        lib.bpf_map_lookup_and_delete_batch.restype = ctypes.c_int
+        lib.libbpf_num_possible_cpus.argtypes = []
+        lib.libbpf_num_possible_cpus.restype = ctypes.c_int
+        return lib
+
+class PacketCaptureService:
+    """AF_XDP consumer for the kernel's sampled evidence capture.
+
+    Binds an AF_XDP socket to one RX queue, registers it in the pinned
+    capture_socks XSKMAP, and writes the sampled packets the XDP
+    program redirects (flag-matched sources, 1-in-N per
+    CFG_CAPTURE_SAMPLE_N) straight from umem into a pcap file. Frames
+    never traverse the network stack; zero-copy mode is requested and
+    driver copy mode is the fallback. Costs nothing while disarmed -
+    the redirect only happens when the config slot is nonzero.
+    """
+
+    # AF_XDP constants (linux/if_xdp.h)
+    AF_XDP = 44
+    SOL_XDP = 283
+    XDP_MMAP_OFFSETS = 1
+    XDP_RX_RING = 2
+    XDP_UMEM_REG = 4
+    XDP_UMEM_FILL_RING = 5
+    XDP_UMEM_COMPLETION_RING = 6
+    XDP_PGOFF_RX_RING = 0
+    XDP_UMEM_PGOFF_FILL_RING = 0x100000000
+    XDP_FLAG_COPY = 1 << 1
+    XDP_FLAG_ZEROCOPY = 1 << 2
+
+    FRAME_SIZE = 2048
+    NUM_FRAMES = 4096       # 8 MB umem
+    RING_SIZE = 2048        # descriptors per ring, power of two
+    PCAP_SNAPLEN = 2048
+
+    def __init__(self, interface: str, queue_id: int = 0,
+                 pcap_path: str = "/var/log/alopex-capture.pcap"):
+        self.interface = interface
+        self.queue_id = queue_id
+        self.pcap_path = pcap_path
+        self.packets_captured = 0
+        self.running = False
+
+        self.sock = None
+        self._umem = None
+        self._rx_ring = None
+        self._fill_ring = None
+        self._offsets = None
+        self._pcap = None
+        self._rx_thread = None
+        self._xskmap_fd = -1
+
+    def start(self, xskmap_pin_path: str) -> bool:
+        """Create the AF_XDP socket and start consuming into pcap"""
+        import threading
+
+        try:
+            if not self._setup_socket():
+                return False
+            if not self._register_in_xskmap(xskmap_pin_path):
+                self.stop()
+                return False
+
+            self._pcap = open(self.pcap_path, "ab")
+            if self._pcap.tell() == 0:
+                self._write_pcap_header()
+
+            self.running = True
+            self._rx_thread = threading.Thread(
+                target=self._rx_loop, name="alopex-capture", daemon=True)
+            self._rx_thread.start()
+
+            logger.info(f"Packet capture armed on {self.interface} "
+                        f"queue {self.queue_id} -> {self.pcap_path}")
+            return True
+        except Exception as e:
+            logger.error(f"Failed to start packet capture: {e}")
+            self.stop()
+            return False
+
+    def stop(self):
+        """Stop consumption and release the socket and umem"""
+        self.running = False
+        if self._rx_thread:
+            self._rx_thread.join(timeout=2)
+            self._rx_thread = None
+        if self._pcap:
+            self._pcap.close()
+            self._pcap = None
+        if self._rx_ring:
+            self._rx_ring.close()
+            self._rx_ring = None
+        if self._fill_ring:
+            self._fill_ring.close()
+            self._fill_ring = None
+        if self.sock:
+            self.sock.close()
+            self.sock = None
+        if self._umem:
+            self._umem.close()
+            self._umem = None
+
+    def _setup_socket(self) -> bool:
+        """Create socket, register umem, map rings, bind to the queue"""
+        import mmap
+        import socket as socket_mod
+
+        self.sock = socket_mod.socket(self.AF_XDP, socket_mod.SOCK_RAW, 0)
+
+        # Anonymous umem backing all frames
+        self._umem = mmap.mmap(-1, self.NUM_FRAMES * self.FRAME_SIZE)
+        umem_addr = ctypes.addressof(ctypes.c_char.from_buffer(self._umem))
+
+        # struct xdp_umem_reg: addr, len, chunk_size, headroom, flags
+        self.sock.setsockopt(self.SOL_XDP, self.XDP_UMEM_REG, struct.pack(
+            "<QQIII", umem_addr, self.NUM_FRAMES * self.FRAME_SIZE,
+            self.FRAME_SIZE, 0, 0))
+        self.sock.setsockopt(self.SOL_XDP, self.XDP_UMEM_FILL_RING,
+                             struct.pack("<I", self.RING_SIZE))
+        self.sock.setsockopt(self.SOL_XDP, self.XDP_UMEM_COMPLETION_RING,
+                             struct.pack("<I", self.RING_SIZE))
+        self.sock.setsockopt(self.SOL_XDP, self.XDP_RX_RING,
+                             struct.pack("<I", self.RING_SIZE))
+
+        # struct xdp_mmap_offsets: rx/tx/fill/completion, each with
+        # producer, consumer, desc (flags appended on newer kernels)
+        raw = self.sock.getsockopt(self.SOL_XDP, self.XDP_MMAP_OFFSETS, 128)
+        fields_per_ring = 4 if len(raw) >= 128 else 3
+        offsets = struct.unpack(f"<{4 * fields_per_ring}Q", raw[:4 * fields_per_ring * 8])
+        rx = offsets[0:3]
+        fill = offsets[2 * fields_per_ring:2 * fields_per_ring + 3]
+        self._offsets = {"rx": rx, "fill": fill}
+
+        # Map the RX descriptor ring and the fill ring off the socket fd
+        fd = self.sock.fileno()
+        self._rx_ring = mmap.mmap(
+            fd, rx[2] + self.RING_SIZE * 16, offset=self.XDP_PGOFF_RX_RING)
+        self._fill_ring = mmap.mmap(
+            fd, fill[2] + self.RING_SIZE * 8, offset=self.XDP_UMEM_PGOFF_FILL_RING)
+
+        # Give every frame to the kernel via the fill ring
+        for i in range(self.RING_SIZE):
+            struct.pack_into("<Q", self._fill_ring, fill[2] + i * 8,
+                             i * self.FRAME_SIZE)
+        struct.pack_into("<I", self._fill_ring, fill[0], self.RING_SIZE)
+
+        # struct sockaddr_xdp; try zero-copy first, fall back to copy
+        ifindex = socket_mod.if_nametoindex(self.interface)
+        for flags in (self.XDP_FLAG_ZEROCOPY, self.XDP_FLAG_COPY):
+            try:
+                self.sock.bind(struct.pack(
+                    "<HHIII", self.AF_XDP, flags, ifindex, self.queue_id, 0))
+                if flags == self.XDP_FLAG_COPY:
+                    logger.info("Zero-copy unsupported by driver - using copy mode")
+                return True
+            except OSError:
+                continue
+
+        logger.error(f"Cannot bind AF_XDP socket to {self.interface}")
+        return False
+
+    def _register_in_xskmap(self, pin_path: str) -> bool:
+        """Point the capture_socks slot for our queue at this socket"""
+        for soname in ("libbpf.so.1", "libbpf.so.0", "libbpf.so"):
+            try:
+                lib = ctypes.CDLL(soname)
+                break
+            except OSError:
+                continue
+        else:
+            logger.warning("libbpf unavailable - cannot register capture socket")
+            return False
+
+        lib.bpf_obj_get.argtypes = [ctypes.c_char_p]
+        lib.bpf_obj_get.restype = ctypes.c_int
+        lib.bpf_map_update_elem.argtypes = [
+            ctypes.c_int, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint64]
+        lib.bpf_map_update_elem.restype = ctypes.c_int
+
+        self._xskmap_fd = lib.bpf_obj_get(pin_path.encode())
+        if self._xskmap_fd < 0:
+            logger.warning(f"Cannot open pinned XSKMAP: {pin_path}")
+            return False
+
+        key = ctypes.c_uint32(self.queue_id)
+        value = ctypes.c_uint32(self.sock.fileno())
+        if lib.bpf_map_update_elem(self._xskmap_fd, ctypes.byref(key),
+                                   ctypes.byref(value), 0) != 0:
+            logger.warning("Failed to insert capture socket into XSKMAP")
+            return False
+        return True
+
+    def _rx_loop(self):
+        """Drain the RX ring into the pcap file, recycling frames"""
+        import select
+
+        rx_prod_off, rx_cons_off, rx_desc_off = self._offsets["rx"]
+        fill_prod_off, _, fill_desc_off = self._offsets["fill"]
+        consumer = struct.unpack_from("<I", self._rx_ring, rx_cons_off)[0]
+        fill_producer = struct.unpack_from("<I", self._fill_ring, fill_prod_off)[0]
+
+        poller = select.poll()
+        poller.register(self.sock.fileno(), select.POLLIN)
+
+        while self.running:
+            if not poller.poll(1000):
+                continue
+
+            producer = struct.unpack_from("<I", self._rx_ring, rx_prod_off)[0]
+            while consumer != producer:
+                slot = consumer & (self.RING_SIZE - 1)
+                addr, length, _ = struct.unpack_from(
+                    "<QII", self._rx_ring, rx_desc_off + slot * 16)
+
+                frame = self._umem[addr:addr + min(length, self.PCAP_SNAPLEN)]
+                self._write_pcap_record(frame, length)
+
+                # Recycle the frame back to the kernel
+                fill_slot = fill_producer & (self.RING_SIZE - 1)
+                struct.pack_into("<Q", self._fill_ring,
+                                 fill_desc_off + fill_slot * 8,
+                                 addr - (addr % self.FRAME_SIZE))
+                fill_producer += 1
+                consumer += 1
+                self.packets_captured += 1
+
+            struct.pack_into("<I", self._rx_ring, rx_cons_off, consumer)
+            struct.pack_into("<I", self._fill_ring, fill_prod_off, fill_producer)
+            self._pcap.flush()
+
+    def _write_pcap_header(self):
+        # pcap global header: magic, v2.4, tz 0, sigfigs 0, snaplen, LINKTYPE_ETHERNET
+        self._pcap.write(struct.pack(
+            "<IHHiIII", 0xa1b2c3d4, 2, 4, 0, 0, self.PCAP_SNAPLEN, 1))
+
+    def _write_pcap_record(self, frame: bytes, wire_length: int):
+        now = time.time()
+        self._pcap.write(struct.pack(
+            "<IIII", int(now), int((now % 1) * 1000000), len(frame), wire_length))
+        self._pcap.write(frame)
+
 class EBPFNetworkMonitor:
     """eBPF-based network anomaly detection"""
-    
+
+    # Pin directory used by the loader for ebpf_monitor.c maps
+    BPF_PIN_DIR = "/sys/fs/bpf/alopex"
+
+    # Must match the #defines in ebpf_monitor.c
+    ALERT_THRESHOLD_NETLINK = 10
+    TIME_WINDOW_SEC = 60
+
+    # How often the export loop runs sweep_expired_entries()
+    MAP_SWEEP_INTERVAL = 60.0  # seconds
+
+    # Slot indices must match enum alopex_config_key in ebpf_monitor.c.
+    # Writing a slot retunes all attached programs immediately - no
+    # recompile, no detach/reattach coverage gap.
+    CONFIG_SLOTS = {
+        "netlink_threshold": 0,
+        "portscan_threshold": 1,
+        "time_window_sec": 2,
+        "feature_disable": 3,
+        "severity_blocklist": 4,
+        "severity_portscan": 5,
+        "capture_sample_n": 6,
+    }
+
+    # Slot order must match enum alopex_xdp_stat in ebpf_monitor.c
+    XDP_STAT_NAMES = [
+        "packets_seen", "packets_passed", "packets_dropped",
+        "blocklist_hits", "syn_packets", "tail_call_misses",
+        "packets_captured",
+    ]
+
+    # Value layouts for the exported tracking maps
+    RATE_ENTRY_STRUCT = struct.Struct("<QII")   # window_start, count, pad
+    SCAN_ENTRY_STRUCT = struct.Struct("<QQII")  # window, bloom, ports, alerted
+
     def __init__(self, security_ctx: SecurityContext):
         self.security_ctx = security_ctx
         self.monitoring_active = False
-        
+        self.alert_consumer: Optional[SecurityAlertConsumer] = None
+        self.map_exporter: Optional[BPFMapExporter] = None
+        self.latest_kernel_state: Dict = {}
+        self._export_thread = None
+        self.capture_service: Optional[PacketCaptureService] = None
+
     def start_monitoring(self) -> bool:
         """Start eBPF network monitoring"""
         if not self.security_ctx.ebpf_monitoring:
@@ -272,15 +961,47 @@ class EBPFNetworkMonitor:
             if not self._load_network_monitor():
                 logger.error("Failed to load eBPF network monitor")
                 return False
-            
+
+            # Populate the XDP blocklist so enforcement starts immediately
+            self.load_network_blocklist()
+
+            # Seed runtime tunables from the enterprise configuration
+            self.load_runtime_config()
+
             self.monitoring_active = True
+
+            # Start draining security_alerts - without a consumer the
+            # kernel produces events straight into the void
+            self.alert_consumer = SecurityAlertConsumer(
+                f"{self.BPF_PIN_DIR}/security_alerts", self.detect_anomaly)
+            if not self.alert_consumer.start():
+                self.alert_consumer = None
+
+            # Periodic batched snapshots of the kernel tracking maps
+            self.start_map_export()
+
             logger.info("eBPF network monitoring active - ALOPEX protected")
             return True
             
         except Exception as e:
             logger.error(f"Failed to start eBPF monitoring: {e}")
             return False
-    
+
+    def stop_monitoring(self):
+        """Stop eBPF monitoring and alert consumption"""
+        self.monitoring_active = False
+        if self.alert_consumer:
+            self.alert_consumer.stop()
+            self.alert_consumer = None
+        if self._export_thread:
+            self._export_thread.join(timeout=2)
+            self._export_thread = None
+        if self.map_exporter:
+            self.map_exporter.close()
+            self.map_exporter = None
+        if self.capture_service:
+            self.disarm_capture()
+
     def _check_bpf_capability(self) -> bool:
         """Check if process can use eBPF"""
         try:
@@ -302,17 +1023,366 @@ class EBPFNetworkMonitor:
         
         return True
     
+    def load_network_blocklist(self) -> int:
+        """Populate the blocked_networks LPM trie from configuration.
+
+        Reads blocked_cidrs/allowed_cidrs from
+        /etc/alopex/critical-networks.json and installs them into the
+        pinned trie; matched sources are then dropped by
+        alopex_network_filter() in XDP before the stack (or iptables)
+        ever sees the traffic. Allow entries use longest-prefix match to
+        punch holes in broader block ranges.
+        """
+        config_file = Path("/etc/alopex/critical-networks.json")
+        if not config_file.exists():
+            return 0
+
+        try:
+            import json
+            with open(config_file) as f:
+                networks = json.load(f)
+        except Exception as e:
+            logger.error(f"Failed to load critical networks config: {e}")
+            return 0
+
+        # Verdict values must match ALOPEX_VERDICT_* in ebpf_monitor.c
+        entries = []
+        for network in networks:
+            for cidr in network.get("blocked_cidrs", []):
+                entries.append((cidr, 1))
+            for cidr in network.get("allowed_cidrs", []):
+                entries.append((cidr, 0))
+
+        installed = 0
+        for cidr, verdict in entries:
+            if self._install_blocklist_entry(cidr, verdict):
+                installed += 1
+
+        if entries:
+            logger.info(f"XDP blocklist loaded: {installed}/{len(entries)} entries")
+        return installed
+
+    def _install_blocklist_entry(self, cidr: str, verdict: int) -> bool:
+        """Install one CIDR into the pinned LPM trie via bpftool"""
+        try:
+            import ipaddress
+            import subprocess
+            network = ipaddress.ip_network(cidr, strict=False)
+            if network.version != 4:
+                logger.warning(f"Skipping non-IPv4 blocklist entry: {cidr}")
+                return False
+
+            # struct alopex_lpm_key: prefixlen (host order) + addr (network order)
+            key = struct.pack("<I", network.prefixlen) + network.network_address.packed
+            result = subprocess.run([
+                'bpftool', 'map', 'update',
+                'pinned', f"{self.BPF_PIN_DIR}/blocked_networks",
+                'key', *[str(b) for b in key],
+                'value', str(verdict)
+            ], capture_output=True, text=True, timeout=5)
+
+            if result.returncode != 0:
+                logger.warning(f"Failed to install blocklist entry {cidr}: {result.stderr.strip()}")
+                return False
+            return True
+        except Exception as e:
+            logger.warning(f"Invalid blocklist entry {cidr}: {e}")
+            return False
+
+    def arm_capture(self, interface: str, sample_n: int = 64,
+                    queue_id: int = 0) -> bool:
+        """Arm sampled evidence capture for flagged scan sources.
+
+        Starts the AF_XDP consumer on the given interface queue, then
+        sets CFG_CAPTURE_SAMPLE_N so the XDP program starts redirecting
+        1-in-N packets from already-alerted sources. Until the config
+        slot is written the kernel side does nothing, so the arming
+        order never captures into the void.
+        """
+        if self.capture_service:
+            return True
+
+        service = PacketCaptureService(interface, queue_id)
+        if not service.start(f"{self.BPF_PIN_DIR}/capture_socks"):
+            return False
+
+        if not self.set_config_value("capture_sample_n", sample_n):
+            service.stop()
+            return False
+
+        self.capture_service = service
+        return True
+
+    def disarm_capture(self):
+        """Stop sampling in the kernel, then tear down the consumer"""
+        self.set_config_value("capture_sample_n", 0)
+        if self.capture_service:
+            self.capture_service.stop()
+            self.capture_service = None
+
+    def start_map_export(self, interval: float = 1.0, publish=None) -> bool:
+        """Start the periodic batched snapshot of kernel tracking state.
+
+        Every `interval` seconds the exporter pulls privilege_tracking,
+        netlink_rate_limit, scan_tracking and the per-stage xdp_stats in
+        a few batch syscalls each, stores the aggregate in
+        latest_kernel_state, pushes over-threshold netlink rates through
+        detect_anomaly(), and hands the snapshot to the optional publish
+        callback (the daemon wires its telemetry ring in here). The
+        loop also hosts the periodic sweep_expired_entries() pass so
+        stale map entries actually get reclaimed.
+        """
+        import threading
+
+        self.map_exporter = BPFMapExporter(self.BPF_PIN_DIR)
+        if not self.map_exporter.available():
+            logger.warning("libbpf unavailable - kernel map export disabled")
+            self.map_exporter = None
+            return False
+
+        def export_loop():
+            last_sweep = time.monotonic()
+            while self.monitoring_active:
+                try:
+                    snapshot = self.snapshot_kernel_state()
+                    self.latest_kernel_state = snapshot
+
+                    # Reclaim entries from processes that went quiet -
+                    # the LRU maps never expire them on their own
+                    if time.monotonic() - last_sweep >= self.MAP_SWEEP_INTERVAL:
+                        last_sweep = time.monotonic()
+                        self.sweep_expired_entries()
+
+                    # Surface aggregated over-threshold rates as anomalies
+                    for uid, rate in snapshot.get("netlink_rate", {}).items():
+                        if rate > self.ALERT_THRESHOLD_NETLINK:
+                            self.detect_anomaly({
+                                "unusual_netlink_patterns": True,
+                                "uid": uid,
+                                "netlink_rate": rate,
+                            })
+
+                    if publish:
+                        publish(snapshot)
+                except Exception as e:
+                    logger.error(f"Kernel map export failed: {e}")
+                time.sleep(interval)
+
+        self._export_thread = threading.Thread(
+            target=export_loop, name="alopex-map-export", daemon=True)
+        self._export_thread.start()
+        return True
+
+    def snapshot_kernel_state(self) -> Dict:
+        """Aggregate one batched snapshot of the kernel tracking maps"""
+        if not self.map_exporter:
+            return {}
+
+        num_cpus = self.map_exporter._num_cpus
+        snapshot: Dict = {"timestamp": time.time()}
+
+        # Per-stage packet counters: sum the per-CPU u64 slots
+        stats = {}
+        for key, value in self.map_exporter.snapshot_map("xdp_stats"):
+            idx = int.from_bytes(key, "little")
+            if idx < len(self.XDP_STAT_NAMES):
+                stats[self.XDP_STAT_NAMES[idx]] = sum(
+                    struct.unpack_from("<Q", value, cpu * 8)[0]
+                    for cpu in range(num_cpus))
+        snapshot["xdp_stats"] = stats
+
+        # Per-UID netlink rates: sum the per-CPU rate entry counts
+        rates = {}
+        stride = (self.RATE_ENTRY_STRUCT.size + 7) & ~7
+        for key, value in self.map_exporter.snapshot_map("netlink_rate_limit"):
+            uid = int.from_bytes(key, "little")
+            rates[uid] = sum(
+                self.RATE_ENTRY_STRUCT.unpack_from(value, cpu * stride)[1]
+                for cpu in range(num_cpus))
+        snapshot["netlink_rate"] = rates
+
+        # Privilege tracking: how many PIDs the kernel is watching
+        snapshot["tracked_pids"] = len(
+            self.map_exporter.snapshot_map("privilege_tracking"))
+
+        # Scan tracking: distinct-port estimates per source
+        scans = {}
+        for key, value in self.map_exporter.snapshot_map("scan_tracking"):
+            src_ip = int.from_bytes(key, "little")
+            _, _, distinct_ports, alerted = self.SCAN_ENTRY_STRUCT.unpack(value)
+            scans[src_ip] = {"distinct_ports": distinct_ports, "alerted": bool(alerted)}
+        snapshot["scan_sources"] = scans
+
+        return snapshot
+
+    def load_runtime_config(self, config_file: str = "/etc/alopex/enterprise.json") -> int:
+        """Apply the ebpf_tuning section of the enterprise config live.
+
+        Reads security.ebpf_tuning from enterprise.json and writes each
+        named tunable into the pinned alopex_config array. Programs read
+        the slots on every invocation, so a changed threshold takes
+        effect on the next packet - call this again after editing the
+        file to retune detection with zero reload.
+        """
+        config_path = Path(config_file)
+        if not config_path.exists():
+            return 0
+
+        try:
+            import json
+            with open(config_path) as f:
+                config = json.load(f)
+        except Exception as e:
+            logger.error(f"Failed to load enterprise config: {e}")
+            return 0
+
+        tuning = config.get("security", {}).get("ebpf_tuning", {})
+        applied = 0
+        for name, value in tuning.items():
+            if name not in self.CONFIG_SLOTS:
+                logger.warning(f"Unknown eBPF tunable: {name}")
+                continue
+            if self.set_config_value(name, int(value)):
+                applied += 1
+
+        if tuning:
+            logger.info(f"eBPF runtime config applied: {applied}/{len(tuning)} tunables")
+        return applied
+
+    def set_config_value(self, name: str, value: int) -> bool:
+        """Write one tunable slot in the pinned alopex_config map"""
+        slot = self.CONFIG_SLOTS.get(name)
+        if slot is None:
+            return False
+
+        try:
+            import subprocess
+            # Key is a __u32 slot index, value a __u64 tunable
+            result = subprocess.run([
+                'bpftool', 'map', 'update',
+                'pinned', f"{self.BPF_PIN_DIR}/alopex_config",
+                'key', *[str(b) for b in slot.to_bytes(4, 'little')],
+                'value', *[str(b) for b in value.to_bytes(8, 'little')]
+            ], capture_output=True, text=True, timeout=5)
+
+            if result.returncode != 0:
+                logger.warning(f"Failed to set eBPF tunable {name}: {result.stderr.strip()}")
+                return False
+            return True
+        except Exception as e:
+            logger.warning(f"Failed to set eBPF tunable {name}: {e}")
+            return False
+
+    def get_netlink_event_rate(self, uid: int) -> int:
+        """Sum the per-CPU netlink_rate_limit slots for a UID.
+
+        The kernel side uses a BPF_MAP_TYPE_PERCPU_HASH so each CPU
+        increments its own slot without cross-CPU contention; the global
+        count only exists after this aggregation.
+        """
+        try:
+            import subprocess
+            result = subprocess.run([
+                'bpftool', '--json', 'map', 'lookup',
+                'pinned', f"{self.BPF_PIN_DIR}/netlink_rate_limit",
+                'key', *[str(b) for b in uid.to_bytes(4, 'little')]
+            ], capture_output=True, text=True, timeout=5)
+
+            if result.returncode != 0:
+                return 0
+
+            import json
+            entry = json.loads(result.stdout)
+            # Per-CPU maps report one value per possible CPU; each value
+            # is a struct alopex_rate_entry with an embedded window start
+            total = 0
+            for cpu_value in entry.get('values', []):
+                value = cpu_value.get('value', 0)
+                if isinstance(value, dict):
+                    value = value.get('count', 0)
+                if isinstance(value, str):
+                    value = int(value, 0)
+                total += value
+            return total
+        except Exception as e:
+            logger.debug(f"Failed to aggregate netlink rate for uid {uid}: {e}")
+            return 0
+
+    def netlink_rate_exceeded(self, uid: int) -> bool:
+        """Evaluate ALERT_THRESHOLD_NETLINK against the cross-CPU sum"""
+        return self.get_netlink_event_rate(uid) > self.ALERT_THRESHOLD_NETLINK
+
+    def sweep_expired_entries(self) -> int:
+        """Batched expiry sweep for entries the LRU maps never evict.
+
+        The kernel side expires rate windows in place on access; entries
+        belonging to processes that simply stopped generating events are
+        reclaimed here by comparing their embedded timestamps against
+        TIME_WINDOW_SEC. Timestamps are bpf_ktime_get_ns() values, so we
+        compare against CLOCK_MONOTONIC.
+        """
+        removed = 0
+        try:
+            import subprocess
+            now_ns = time.clock_gettime_ns(time.CLOCK_MONOTONIC)
+            cutoff_ns = now_ns - self.TIME_WINDOW_SEC * 1_000_000_000
+
+            for map_name, ts_field in [("alopex_events", "timestamp"),
+                                       ("privilege_tracking", None)]:
+                result = subprocess.run([
+                    'bpftool', '--json', 'map', 'dump',
+                    'pinned', f"{self.BPF_PIN_DIR}/{map_name}"
+                ], capture_output=True, text=True, timeout=10)
+
+                if result.returncode != 0:
+                    continue
+
+                import json
+                for entry in json.loads(result.stdout):
+                    value = entry.get('value')
+                    if ts_field and isinstance(value, dict):
+                        timestamp = value.get(ts_field, 0)
+                    else:
+                        timestamp = value
+                    if isinstance(timestamp, str):
+                        timestamp = int(timestamp, 0)
+                    if not isinstance(timestamp, int) or timestamp >= cutoff_ns:
+                        continue
+
+                    key = entry.get('key')
+                    if isinstance(key, dict) or key is None:
+                        continue
+                    key_bytes = key if isinstance(key, list) else \
+                        [str(b) for b in int(key).to_bytes(4, 'little')]
+                    delete = subprocess.run([
+                        'bpftool', 'map', 'delete',
+                        'pinned', f"{self.BPF_PIN_DIR}/{map_name}",
+                        'key', *[str(b) for b in key_bytes]
+                    ], capture_output=True, timeout=5)
+                    if delete.returncode == 0:
+                        removed += 1
+
+            if removed:
+                logger.debug(f"Expired {removed} stale eBPF map entries")
+        except Exception as e:
+            logger.debug(f"eBPF map sweep failed: {e}")
+        return removed
+
     def detect_anomaly(self, network_event: Dict) -> bool:
         """Detect network anomalies using eBPF data"""
         if not self.monitoring_active:
             return False
             
-        # Implement anomaly detection logic
+        # Implement anomaly detection logic - the indicator keys must
+        # cover everything SecurityAlertConsumer.EVENT_INDICATORS maps
+        # kernel event types to
         suspicious_indicators = [
             network_event.get('rapid_config_changes', False),
             network_event.get('privilege_escalation_attempt', False),
             network_event.get('unusual_netlink_patterns', False),
-            network_event.get('unauthorized_interface_access', False)
+            network_event.get('unauthorized_interface_access', False),
+            network_event.get('suspicious_network_pattern', False),
+            network_event.get('malicious_pattern', False)
         ]
         
         if any(suspicious_indicators):
@@ -321,15 +1391,49 @@ class EBPFNetworkMonitor:
             
         return False
 
+class TokenBucketRateLimiter:
+    """O(1) token-bucket rate limiter keyed by caller-chosen strings.
+
+    Each key holds a token count and a last-refill timestamp; allow()
+    refills proportionally to elapsed time and consumes one token, so
+    the cost per check is constant no matter how hard the key is being
+    hammered. Reusable anywhere a cheap rate gate is needed (security
+    validation, reconnect backpressure, the compat control socket).
+    """
+
+    def __init__(self, rate: float, burst: int):
+        self.rate = float(rate)    # tokens replenished per second
+        self.burst = float(burst)  # bucket capacity
+        self._buckets: Dict[str, List[float]] = {}
+
+    def allow(self, key: str) -> bool:
+        """Consume one token for key; False means rate exceeded"""
+        now = time.monotonic()
+        bucket = self._buckets.get(key)
+        if bucket is None:
+            self._buckets[key] = [self.burst - 1.0, now]
+            return True
+
+        tokens, last_refill = bucket
+        tokens = min(self.burst, tokens + (now - last_refill) * self.rate)
+        bucket[1] = now
+        if tokens < 1.0:
+            bucket[0] = tokens
+            return False
+        bucket[0] = tokens - 1.0
+        return True
+
 class ALOPEXSecurityManager:
     """Main security manager for ALOPEX"""
-    
+
     def __init__(self, security_level: SecurityLevel = SecurityLevel.ENTERPRISE):
         self.security_level = security_level
         self.security_ctx = None
         self.capability_manager = CapabilityManager()
         self.ebpf_monitor = None
-        
+        # Max 10 operations per minute per operation type in paranoid mode
+        self.rate_limiter = TokenBucketRateLimiter(rate=10 / 60.0, burst=10)
+
     def initialize_security(self) -> bool:
         """Initialize complete security context"""
         try:
@@ -506,27 +1610,8 @@ class ALOPEXSecurityManager:
         return True
     
     def _check_rate_limit(self, operation: str) -> bool:
-        """Check operation rate limiting"""
-        # Simple rate limiting - could be enhanced
-        if not hasattr(self, '_operation_timestamps'):
-            self._operation_timestamps = {}
-        
-        now = time.time()
-        if operation not in self._operation_timestamps:
-            self._operation_timestamps[operation] = []
-        
-        # Clean old timestamps (1 minute window)
-        self._operation_timestamps[operation] = [
-            ts for ts in self._operation_timestamps[operation]
-            if now - ts < 60
-        ]
-        
-        # Check limit (max 10 operations per minute in paranoid mode)
-        if len(self._operation_timestamps[operation]) >= 10:
-            return False
-        
-        self._operation_timestamps[operation].append(now)
-        return True
+        """Check operation rate limiting - O(1) token bucket per operation"""
+        return self.rate_limiter.allow(operation)
 
 # Security utilities
 def get_security_recommendations() -> Dict[str, str]:
@@ -3,9 +3,12 @@ Connection State Management - Persistent network configuration
 Enterprise-grade connection handling that NetworkManager wishes it had
 """
 
+import atexit
 import json
+import os
 import asyncio
 import logging
+import threading
 import time
 from pathlib import Path
 from typing import Dict, List, Optional, Tuple
@@ -80,6 +83,24 @@ class ConnectionManager:
         # Monitoring
         self.monitoring = True
         self.reconnect_interval = 30  # seconds
+        self.connect_timeout = 45  # per-interface auto-connect deadline
+
+        # Adaptive health-check scheduling: every interface runs its own
+        # check loop, stable ones back off toward minutes, freshly
+        # flapped ones are rechecked sub-second
+        self.monitor_min_interval = 0.5  # seconds, right after a flap
+        self.monitor_base_interval = 10.0  # first check of a new interface
+        self.monitor_max_interval = 300.0  # ceiling for stable interfaces
+        self.monitor_topology_interval = 15.0  # sysfs rescan for hotplug
+
+        # Debounced persistence: mutations mark state dirty and disk is
+        # touched at most once per interval; flush() is forced at exit
+        self.flush_interval = 5.0  # seconds
+        self._profiles_dirty = False
+        self._states_dirty = False
+        self._last_flush = 0.0
+        self._flush_timer: Optional[threading.Timer] = None
+        atexit.register(self.flush)
         
         # Setup logging
         self.logger = logging.getLogger("connection_manager")
@@ -103,15 +124,9 @@ class ConnectionManager:
                 self.logger.error(f"Failed to load profiles: {e}")
     
     def _save_profiles(self):
-        """Save connection profiles to persistent storage"""
-        self.config_path.mkdir(parents=True, exist_ok=True)
-        
-        try:
-            data = {name: asdict(profile) for name, profile in self.profiles.items()}
-            with open(self.profiles_file, 'w') as f:
-                json.dump(data, f, indent=2)
-        except Exception as e:
-            self.logger.error(f"Failed to save profiles: {e}")
+        """Mark profiles dirty; written by the next debounced flush"""
+        self._profiles_dirty = True
+        self._maybe_flush()
     
     def _load_states(self):
         """Load connection states"""
@@ -127,15 +142,70 @@ class ConnectionManager:
                 self.logger.error(f"Failed to load states: {e}")
     
     def _save_states(self):
-        """Save connection states"""
+        """Mark states dirty; written by the next debounced flush"""
+        self._states_dirty = True
+        self._maybe_flush()
+
+    def _maybe_flush(self):
+        """Flush if the debounce interval has elapsed, else arm a timer.
+
+        The health monitor and connect paths call _save_* on every
+        status wiggle; debouncing turns that into at most one write per
+        flush_interval instead of a full rewrite per call. The deferred
+        timer guarantees the tail of a mutation burst still reaches
+        disk within flush_interval even if no further mutation ever
+        arrives to trigger the next check.
+        """
+        if time.time() - self._last_flush >= self.flush_interval:
+            self.flush()
+        elif self._flush_timer is None:
+            delay = self.flush_interval - (time.time() - self._last_flush)
+            self._flush_timer = threading.Timer(max(delay, 0.1), self.flush)
+            self._flush_timer.daemon = True
+            self._flush_timer.start()
+
+    def flush(self):
+        """Write all dirty state to disk via fsynced atomic replace"""
+        if self._flush_timer is not None:
+            self._flush_timer.cancel()
+            self._flush_timer = None
+
+        if not (self._profiles_dirty or self._states_dirty):
+            return
+
         self.config_path.mkdir(parents=True, exist_ok=True)
-        
-        try:
-            data = {iface: asdict(state) for iface, state in self.interface_states.items()}
-            with open(self.state_file, 'w') as f:
-                json.dump(data, f, indent=2)
-        except Exception as e:
-            self.logger.error(f"Failed to save states: {e}")
+
+        if self._profiles_dirty:
+            try:
+                data = {name: asdict(profile) for name, profile in self.profiles.items()}
+                self._write_json_atomic(self.profiles_file, data)
+                self._profiles_dirty = False
+            except Exception as e:
+                self.logger.error(f"Failed to save profiles: {e}")
+
+        if self._states_dirty:
+            try:
+                data = {iface: asdict(state) for iface, state in self.interface_states.items()}
+                self._write_json_atomic(self.state_file, data)
+                self._states_dirty = False
+            except Exception as e:
+                self.logger.error(f"Failed to save states: {e}")
+
+        self._last_flush = time.time()
+
+    @staticmethod
+    def _write_json_atomic(path: Path, data: dict):
+        """Write JSON through a fsynced temp file and atomic rename.
+
+        A crash mid-write leaves either the old file or the new one,
+        never a truncated mix - the rename is the commit point.
+        """
+        tmp_path = path.with_suffix(path.suffix + ".tmp")
+        with open(tmp_path, 'w') as f:
+            json.dump(data, f, indent=2)
+            f.flush()
+            os.fsync(f.fileno())
+        os.replace(tmp_path, path)
     
     def create_profile(self, name: str, interface: str, connection_type: str, 
                       method: str = "dhcp", **kwargs) -> ConnectionProfile:
@@ -341,12 +411,27 @@ class ConnectionManager:
             self.logger.error(f"Failed to update connection info for {interface}: {e}")
     
     async def auto_connect_all(self):
-        """Auto-connect all interfaces with auto-connect profiles"""
+        """Auto-connect all interfaces with auto-connect profiles.
+
+        Interfaces are brought up concurrently so one slow DHCP server
+        or WiFi association does not serialize the rest; each interface
+        gets its own deadline and a timeout only sacrifices that
+        interface, not the whole pass.
+        """
         interfaces = self.discovery.discover_interfaces()
-        
-        for interface in interfaces:
-            if interface.status != "Connected":
-                await self.auto_connect_interface(interface.name)
+        pending = [iface for iface in interfaces if iface.status != "Connected"]
+        if not pending:
+            return
+
+        async def bring_up(name: str):
+            try:
+                await asyncio.wait_for(self.auto_connect_interface(name),
+                                       timeout=self.connect_timeout)
+            except asyncio.TimeoutError:
+                self.logger.warning(
+                    f"Auto-connect deadline ({self.connect_timeout}s) exceeded for {name}")
+
+        await asyncio.gather(*(bring_up(iface.name) for iface in pending))
     
     async def auto_connect_interface(self, interface: str):
         """Auto-connect a specific interface using best available profile"""
@@ -362,44 +447,116 @@ class ConnectionManager:
         return False
     
     async def monitor_connections(self):
-        """Monitor connections and handle reconnection"""
+        """Supervise per-interface health check tasks.
+
+        Each interface runs its own check loop with an adaptive
+        interval, so a pass no longer serializes the fleet: stable
+        interfaces back off exponentially toward monitor_max_interval
+        while one that just flapped is rechecked at sub-second cadence
+        until it settles. This loop only tracks topology - a cheap
+        sysfs directory listing - spawning a task for each new
+        interface and cancelling tasks whose interface vanished.
+        Monitoring cost tracks instability, not interface count.
+        """
+        check_tasks: Dict[str, asyncio.Task] = {}
+        try:
+            while self.monitoring:
+                try:
+                    names = self._list_interface_names()
+                    for name in names:
+                        task = check_tasks.get(name)
+                        if task is None or task.done():
+                            check_tasks[name] = asyncio.create_task(
+                                self._monitor_interface(name))
+                    for name in list(check_tasks):
+                        if name not in names:
+                            check_tasks.pop(name).cancel()
+
+                    await asyncio.sleep(self.monitor_topology_interval)
+
+                except Exception as e:
+                    self.logger.error(f"Connection monitoring error: {e}")
+                    await asyncio.sleep(30)  # Back off on errors
+        finally:
+            for task in check_tasks.values():
+                task.cancel()
+
+    @staticmethod
+    def _list_interface_names() -> List[str]:
+        """Current interface names from sysfs - no subprocess, no discovery"""
+        try:
+            return [name for name in os.listdir("/sys/class/net")
+                    if name != "lo"]
+        except OSError:
+            return []
+
+    @staticmethod
+    def _read_interface_status(name: str) -> Optional[str]:
+        """Read operstate directly; None means the interface vanished"""
+        try:
+            with open(f"/sys/class/net/{name}/operstate") as f:
+                state = f.read().strip()
+        except OSError:
+            return None
+        return {"up": "Connected", "down": "Disconnected",
+                "dormant": "Connecting"}.get(state, "Unknown")
+
+    async def _monitor_interface(self, name: str):
+        """Health check loop for one interface with adaptive interval.
+
+        A status change resets the interval to monitor_min_interval so
+        reconnect decisions land within a second of a flap; every quiet
+        check doubles it until monitor_max_interval, so a box full of
+        stable interfaces wakes each one a handful of times per hour.
+        """
+        interval = self.monitor_base_interval
+        last_status = None
+
         while self.monitoring:
-            try:
-                current_interfaces = self.discovery.discover_interfaces()
-                
-                for interface in current_interfaces:
-                    await self._check_interface_health(interface)
-                
-                await asyncio.sleep(10)  # Check every 10 seconds
-                
-            except Exception as e:
-                self.logger.error(f"Connection monitoring error: {e}")
-                await asyncio.sleep(30)  # Back off on errors
-    
-    async def _check_interface_health(self, interface: NetworkInterface):
-        """Check health of a specific interface"""
-        if interface.name not in self.interface_states:
+            status = self._read_interface_status(name)
+            if status is None:
+                return  # Interface removed; supervisor drops the task
+
+            flapped = last_status is not None and status != last_status
+            last_status = status
+            self._apply_health_result(name, status)
+
+            if flapped:
+                interval = self.monitor_min_interval
+            else:
+                interval = min(interval * 2, self.monitor_max_interval)
+            await asyncio.sleep(interval)
+
+    def _apply_health_result(self, name: str, status: str):
+        """Fold one health check result into the shared ConnectionState"""
+        if name not in self.interface_states:
             return
-        
-        state = self.interface_states[interface.name]
+
+        state = self.interface_states[name]
         now = time.time()
-        
-        # Update last seen
+
+        # Update last seen (in memory only - a quiet check is not worth
+        # dirtying the persisted state on every wakeup)
         state.last_seen = now
-        
+
         # Check if previously connected interface is now disconnected
-        if (state.status == "connected" and interface.status != "Connected" and 
+        if (state.status == "connected" and status != "Connected" and
             state.connected_at and (now - state.connected_at) > 30):
-            
-            self.logger.warning(f"Interface {interface.name} unexpectedly disconnected")
+
+            self.logger.warning(f"Interface {name} unexpectedly disconnected")
             state.status = "disconnected"
-            
+
             # Attempt reconnection if we have a profile
             if state.profile_name:
                 self.logger.info(f"Attempting reconnection: {state.profile_name}")
                 asyncio.create_task(self.connect_profile(state.profile_name))
-        
-        self._save_states()
+
+            # Only a status transition is persisted
+            self._save_states()
+
+    async def _check_interface_health(self, interface: NetworkInterface):
+        """Check health of a specific interface from a discovery snapshot"""
+        self._apply_health_result(interface.name, interface.status)
     
     def get_interface_state(self, interface: str) -> Optional[ConnectionState]:
         """Get current connection state for interface"""
@@ -0,0 +1,110 @@
+"""
+ALOPEX Daemon Client
+Shared client for the alopexd control socket
+"""
+
+import json
+import socket
+import logging
+from typing import Dict, List, Optional
+
+# Configure logging
+logger = logging.getLogger(__name__)
+
+# Must match CONTROL_SOCKET_PATH in alopexd.py
+CONTROL_SOCKET_PATH = "/run/alopex/alopexd.sock"
+
+class AlopexDaemonClient:
+    """Client for the alopexd control socket.
+
+    Speaks the daemon's newline-delimited JSON protocol over a UNIX
+    stream socket. Both the GUI and the nmcli shim use this instead of
+    running their own NetworkDiscovery/WiFiManager subprocess storms:
+    one poller, one cache, one privilege boundary in the daemon. The
+    module deliberately imports nothing heavy so callers that only want
+    the daemon path stay fast to start.
+    """
+
+    REQUEST_TIMEOUT = 10.0
+
+    def __init__(self, socket_path: str = CONTROL_SOCKET_PATH):
+        self.socket_path = socket_path
+        self.sock = None
+
+    def connect(self) -> bool:
+        """Try to reach the daemon; False means it is not running"""
+        try:
+            sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            sock.settimeout(self.REQUEST_TIMEOUT)
+            sock.connect(self.socket_path)
+        except OSError as e:
+            logger.debug(f"Daemon control socket unavailable: {e}")
+            return False
+        self.sock = sock
+        return True
+
+    def is_connected(self) -> bool:
+        return self.sock is not None
+
+    def close(self):
+        if self.sock:
+            self.sock.close()
+            self.sock = None
+
+    def request(self, op: str, **request_args):
+        """Send one request and return its data; raises on daemon error.
+
+        Connection-level failures close the socket so the caller can
+        fall back to its local backend and retry connect() later.
+        """
+        if not self.sock:
+            raise ConnectionError("not connected to daemon")
+
+        try:
+            self.sock.sendall(
+                json.dumps({"op": op, "args": request_args}).encode() + b"\n")
+            buf = b""
+            while not buf.endswith(b"\n"):
+                chunk = self.sock.recv(65536)
+                if not chunk:
+                    raise ConnectionError("daemon closed control socket")
+                buf += chunk
+        except (OSError, ConnectionError):
+            self.close()
+            raise
+
+        response = json.loads(buf)
+        if not response.get("ok"):
+            raise RuntimeError(response.get("error", "daemon request failed"))
+        return response.get("data")
+
+    # TYPED HELPERS - reconstruct the network dataclasses for GUI callers
+    def get_interfaces(self) -> List:
+        """Fetch interface state as NetworkInterface objects"""
+        # Imported lazily so lightweight callers (nmcli shim) never pay
+        # for the discovery module
+        from network.discovery import NetworkInterface, NetworkMetrics
+
+        interfaces = []
+        for data in self.request("interfaces"):
+            metrics = data.pop("metrics", None)
+            interfaces.append(NetworkInterface(
+                **data, metrics=NetworkMetrics(**metrics) if metrics else None))
+        return interfaces
+
+    def get_profiles(self) -> Dict[str, dict]:
+        """Fetch connection profiles keyed by name"""
+        return self.request("profiles")
+
+    def scan_wifi(self, device: str) -> List[dict]:
+        """Scan WiFi networks through the daemon's cached scanner"""
+        return self.request("wifi_scan", device=device)
+
+    def connect_profile(self, name: str) -> bool:
+        return bool(self.request("connect_profile", name=name))
+
+    def disconnect_interface(self, interface: str) -> bool:
+        return bool(self.request("disconnect_interface", interface=interface))
+
+    def auto_connect_interface(self, interface: str) -> bool:
+        return bool(self.request("auto_connect_interface", interface=interface))
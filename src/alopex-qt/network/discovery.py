@@ -4,12 +4,18 @@ Port of our Rust network logic to Python
 """
 
 import os
+import socket
 import subprocess
 import time
 from typing import Dict, List, Optional, Tuple
 from dataclasses import dataclass
 from pathlib import Path
 
+# rtnetlink multicast groups (linux/rtnetlink.h)
+RTMGRP_LINK = 0x01
+RTMGRP_IPV4_IFADDR = 0x10
+RTMGRP_IPV4_ROUTE = 0x40
+
 @dataclass
 class NetworkMetrics:
     """Comprehensive network metrics"""
@@ -50,28 +56,156 @@ class NetworkInterface:
 class NetworkDiscovery:
     """Network interface discovery and monitoring"""
     
+    # Event-driven discovery cache: the full pass (subprocess dumps,
+    # per-interface sysfs walks) only re-runs after the kernel reports a
+    # link/address/route change on the monitor socket below. Between
+    # changes only the byte/packet counters are refreshed, which is a
+    # single /proc/net/dev read.
+    _cached_interfaces: Optional[List['NetworkInterface']] = None
+    _change_monitor: Optional[socket.socket] = None
+    _monitor_failed = False
+
     def __init__(self):
         self.previous_metrics: Dict[str, NetworkMetrics] = {}
         self.last_update = time.time()
-    
+
+    @classmethod
+    def _ensure_change_monitor(cls) -> Optional[socket.socket]:
+        """Lazily subscribe to rtnetlink change notifications"""
+        if cls._change_monitor or cls._monitor_failed:
+            return cls._change_monitor
+        try:
+            sock = socket.socket(socket.AF_NETLINK, socket.SOCK_RAW,
+                                 socket.NETLINK_ROUTE)
+            sock.bind((0, RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV4_ROUTE))
+            sock.setblocking(False)
+            cls._change_monitor = sock
+        except Exception:
+            # No netlink access (e.g. restricted namespace) - caching
+            # stays disabled and every call does a full pass
+            cls._monitor_failed = True
+        return cls._change_monitor
+
+    @classmethod
+    def _network_changed(cls) -> bool:
+        """Drain the monitor socket; True if the kernel reported changes"""
+        sock = cls._ensure_change_monitor()
+        if not sock:
+            return True
+        changed = False
+        try:
+            while True:
+                if not sock.recv(65536):
+                    break
+                changed = True
+        except (BlockingIOError, InterruptedError):
+            pass
+        except OSError:
+            # Socket died - force full passes until it can be rebuilt
+            cls._change_monitor = None
+            return True
+        return changed
+
+    @classmethod
+    def invalidate_cache(cls):
+        """Force the next discover_interfaces() call to do a full pass"""
+        cls._cached_interfaces = None
+
     @staticmethod
     def discover_interfaces() -> List[NetworkInterface]:
-        """Discover all network interfaces"""
+        """Discover all network interfaces.
+
+        System-wide state (addresses, default gateway, DNS) is collected
+        once per pass instead of once per interface, and the whole
+        result is cached until rtnetlink reports a change - between
+        changes a call is one /proc/net/dev read to refresh counters.
+        """
+        cls = NetworkDiscovery
+        if cls._cached_interfaces is not None and not cls._network_changed():
+            counters = cls._read_proc_net_dev()
+            for interface in cls._cached_interfaces:
+                interface.metrics = cls._get_interface_metrics(
+                    interface.name, counters.get(interface.name))
+            return cls._cached_interfaces
+
         interfaces = []
         net_path = Path("/sys/class/net")
-        
+
         if not net_path.exists():
             return interfaces
-            
+
+        # One dump covers every interface
+        addresses = NetworkDiscovery._collect_addresses()
+        gateway = NetworkDiscovery._get_default_gateway()
+        dns = NetworkDiscovery._get_dns_servers()
+        counters = NetworkDiscovery._read_proc_net_dev()
+
         for interface_dir in net_path.iterdir():
             if interface_dir.is_dir() and interface_dir.name != "lo":
-                interface = NetworkDiscovery._get_interface_info(interface_dir.name)
+                interface = NetworkDiscovery._get_interface_info(
+                    interface_dir.name,
+                    ip=addresses.get(interface_dir.name),
+                    gateway=gateway,
+                    dns=dns,
+                    counters=counters.get(interface_dir.name)
+                )
                 if interface:
                     interfaces.append(interface)
-        
+
         # Sort by type and name for consistent ordering
         interfaces.sort(key=lambda x: (NetworkDiscovery._type_priority(x.interface_type), x.name))
+
+        # Valid until the next rtnetlink change notification
+        if cls._change_monitor:
+            cls._cached_interfaces = interfaces
         return interfaces
+
+    @staticmethod
+    def _collect_addresses() -> Dict[str, str]:
+        """Collect IPv4 addresses for all interfaces in a single dump"""
+        addresses: Dict[str, str] = {}
+        try:
+            import json
+            result = subprocess.run(
+                ["ip", "-j", "addr", "show"],
+                capture_output=True, text=True, check=True
+            )
+            for entry in json.loads(result.stdout):
+                name = entry.get("ifname")
+                if not name:
+                    continue
+                for addr_info in entry.get("addr_info", []):
+                    addr = addr_info.get("local")
+                    if addr_info.get("family") == "inet" and addr != "127.0.0.1":
+                        addresses[name] = addr
+                        break
+            return addresses
+        except Exception:
+            pass
+
+        # Fallback for iproute2 without JSON support: still one dump,
+        # tracked by the "N: <name>:" section headers
+        try:
+            result = subprocess.run(
+                ["ip", "addr", "show"],
+                capture_output=True, text=True, check=True
+            )
+            current = None
+            for line in result.stdout.split('\n'):
+                if line and not line[0].isspace():
+                    parts = line.split(':')
+                    if len(parts) >= 2:
+                        current = parts[1].strip().split('@')[0]
+                    continue
+                line = line.strip()
+                if current and current not in addresses and \
+                        line.startswith("inet ") and "127.0.0.1" not in line:
+                    parts = line.split()
+                    if len(parts) >= 2:
+                        addresses[current] = parts[1].split('/')[0]
+        except Exception:
+            pass
+        return addresses
     
     @staticmethod
     def _type_priority(interface_type: str) -> int:
@@ -80,15 +214,26 @@ class NetworkDiscovery:
         return priorities.get(interface_type, 3)
     
     @staticmethod
-    def _get_interface_info(name: str) -> Optional[NetworkInterface]:
-        """Get detailed information for a network interface"""
+    def _get_interface_info(name: str, ip: Optional[str] = None,
+                            gateway: Optional[str] = None,
+                            dns: Optional[List[str]] = None,
+                            counters: Optional[Tuple[int, ...]] = None) -> Optional[NetworkInterface]:
+        """Get detailed information for a network interface.
+
+        Shared pass data (ip/gateway/dns) can be supplied by the caller
+        to avoid per-interface subprocess invocations; each falls back
+        to an individual query when called standalone.
+        """
         try:
             interface_type = NetworkDiscovery._detect_interface_type(name)
             status = NetworkDiscovery._get_interface_status(name)
-            ip = NetworkDiscovery._get_interface_ip(name)
-            gateway = NetworkDiscovery._get_default_gateway()
-            dns = NetworkDiscovery._get_dns_servers()
-            metrics = NetworkDiscovery._get_interface_metrics(name)
+            if ip is None:
+                ip = NetworkDiscovery._get_interface_ip(name)
+            if gateway is None:
+                gateway = NetworkDiscovery._get_default_gateway()
+            if dns is None:
+                dns = NetworkDiscovery._get_dns_servers()
+            metrics = NetworkDiscovery._get_interface_metrics(name, counters)
             
             return NetworkInterface(
                 name=name,
@@ -186,47 +331,87 @@ class NetworkDiscovery:
         except:
             return ["8.8.8.8"]  # Fallback
     
+    # Link capabilities (speed/duplex/mtu) rarely change, so the three
+    # sysfs reads per interface are cached for a short TTL
+    _link_caps_cache: Dict[str, Tuple[float, Optional[int], Optional[str], Optional[int]]] = {}
+    LINK_CAPS_TTL = 30.0  # seconds
+
     @staticmethod
-    def _get_interface_metrics(name: str) -> NetworkMetrics:
-        """Get comprehensive interface metrics from /proc/net/dev"""
+    def _read_proc_net_dev() -> Dict[str, Tuple[int, ...]]:
+        """Parse /proc/net/dev once into per-interface counter tuples.
+
+        Returns {name: (bytes_rx, packets_rx, errors_rx, dropped_rx,
+        bytes_tx, packets_tx, errors_tx, dropped_tx)} so a discovery
+        pass reads the file a single time regardless of interface count.
+        """
+        counters: Dict[str, Tuple[int, ...]] = {}
         try:
             with open("/proc/net/dev") as f:
                 for line in f:
-                    if f"{name}:" in line:
-                        parts = line.split()
-                        if len(parts) >= 17:
-                            # Parse all fields from /proc/net/dev
-                            bytes_rx = int(parts[1])
-                            packets_rx = int(parts[2])
-                            errors_rx = int(parts[3])
-                            dropped_rx = int(parts[4])
-                            
-                            bytes_tx = int(parts[9])
-                            packets_tx = int(parts[10])
-                            errors_tx = int(parts[11])
-                            dropped_tx = int(parts[12])
-                            
-                            # Get interface capabilities
-                            link_speed = NetworkDiscovery._get_link_speed(name)
-                            duplex = NetworkDiscovery._get_duplex(name)
-                            mtu = NetworkDiscovery._get_mtu(name)
-                            
-                            return NetworkMetrics(
-                                bytes_tx=bytes_tx,
-                                bytes_rx=bytes_rx,
-                                packets_tx=packets_tx,
-                                packets_rx=packets_rx,
-                                errors_tx=errors_tx,
-                                errors_rx=errors_rx,
-                                dropped_tx=dropped_tx,
-                                dropped_rx=dropped_rx,
-                                link_speed=link_speed,
-                                duplex=duplex,
-                                mtu=mtu
-                            )
+                    if ':' not in line:
+                        continue
+                    name, fields = line.split(':', 1)
+                    parts = fields.split()
+                    if len(parts) >= 16:
+                        counters[name.strip()] = (
+                            int(parts[0]), int(parts[1]), int(parts[2]), int(parts[3]),
+                            int(parts[8]), int(parts[9]), int(parts[10]), int(parts[11])
+                        )
+        except Exception as e:
+            print(f"Error reading /proc/net/dev: {e}")
+        return counters
+
+    @staticmethod
+    def _get_link_capabilities(name: str) -> Tuple[Optional[int], Optional[str], Optional[int]]:
+        """Get (link_speed, duplex, mtu), cached for LINK_CAPS_TTL"""
+        now = time.time()
+        cached = NetworkDiscovery._link_caps_cache.get(name)
+        if cached and now - cached[0] < NetworkDiscovery.LINK_CAPS_TTL:
+            return cached[1], cached[2], cached[3]
+
+        link_speed = NetworkDiscovery._get_link_speed(name)
+        duplex = NetworkDiscovery._get_duplex(name)
+        mtu = NetworkDiscovery._get_mtu(name)
+        NetworkDiscovery._link_caps_cache[name] = (now, link_speed, duplex, mtu)
+        return link_speed, duplex, mtu
+
+    @staticmethod
+    def _get_interface_metrics(name: str,
+                               counters: Optional[Tuple[int, ...]] = None) -> NetworkMetrics:
+        """Get comprehensive interface metrics from /proc/net/dev.
+
+        Callers doing a full pass supply the counters from a single
+        _read_proc_net_dev() dump; standalone callers fall back to
+        reading the file themselves. Speed deltas are computed by
+        update_speeds() against the previous pass.
+        """
+        try:
+            if counters is None:
+                counters = NetworkDiscovery._read_proc_net_dev().get(name)
+
+            if counters:
+                (bytes_rx, packets_rx, errors_rx, dropped_rx,
+                 bytes_tx, packets_tx, errors_tx, dropped_tx) = counters
+
+                # Get interface capabilities (cached)
+                link_speed, duplex, mtu = NetworkDiscovery._get_link_capabilities(name)
+
+                return NetworkMetrics(
+                    bytes_tx=bytes_tx,
+                    bytes_rx=bytes_rx,
+                    packets_tx=packets_tx,
+                    packets_rx=packets_rx,
+                    errors_tx=errors_tx,
+                    errors_rx=errors_rx,
+                    dropped_tx=dropped_tx,
+                    dropped_rx=dropped_rx,
+                    link_speed=link_speed,
+                    duplex=duplex,
+                    mtu=mtu
+                )
         except Exception as e:
             print(f"Error getting metrics for {name}: {e}")
-        
+
         return NetworkMetrics()
     
     @staticmethod
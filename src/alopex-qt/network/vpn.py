@@ -7,6 +7,7 @@ import subprocess
 import asyncio
 import logging
 import re
+import time
 from pathlib import Path
 from typing import List, Optional, Dict
 from dataclasses import dataclass, field
@@ -40,7 +41,81 @@ class VpnConfig:
 
 class VpnManager:
     """WireGuard and OpenVPN management"""
-    
+
+    # WireGuard state watcher: one 'wg show all dump' (stable
+    # tab-separated machine format) covers every interface and is cached
+    # briefly, so bursts of status queries share a single subprocess
+    # instead of each re-running and re-parsing human-readable output.
+    WG_STATE_TTL = 2.0  # seconds
+
+    _wg_state: Optional[Dict] = None
+    _wg_state_time: float = 0.0
+
+    # Health probe results cached per interface: the ping/DNS round
+    # trip dominates get_connection_health(), so bursts of queries
+    # within the freshness window are served from the last probe
+    HEALTH_TTL = 10.0  # seconds
+
+    _health_cache: Dict[str, tuple] = {}  # interface -> (probed_at, health)
+
+    @classmethod
+    def _get_wg_state(cls, refresh: bool = False) -> Optional[Dict]:
+        """Get WireGuard state for all interfaces from the dump format.
+
+        Returns the same structure as _parse_wg_status() so existing
+        callers are agnostic to the source, or None when the dump is
+        unavailable (no wg binary, no privileges).
+        """
+        now = time.time()
+        if not refresh and cls._wg_state is not None and \
+                now - cls._wg_state_time < cls.WG_STATE_TTL:
+            return cls._wg_state
+
+        try:
+            result = subprocess.run(['wg', 'show', 'all', 'dump'],
+                                    capture_output=True, text=True, timeout=5)
+            if result.returncode != 0:
+                return None
+        except Exception:
+            return None
+
+        state: Dict[str, Dict] = {}
+        for line in result.stdout.split('\n'):
+            if not line.strip():
+                continue
+            fields = line.split('\t')
+            interface = fields[0]
+
+            if len(fields) == 5:
+                # Interface row: ifname, private key, public key, port, fwmark
+                state[interface] = {
+                    'peers': [],
+                    'public_key': fields[2] if fields[2] != '(none)' else None,
+                    'listening_port': fields[3]
+                }
+            elif len(fields) == 9 and interface in state:
+                # Peer row: ifname, public key, psk, endpoint, allowed-ips,
+                # latest handshake (unix), rx bytes, tx bytes, keepalive
+                handshake = None
+                try:
+                    handshake_ts = int(fields[5])
+                    if handshake_ts > 0:
+                        handshake = f"{int(now - handshake_ts)} seconds ago"
+                except ValueError:
+                    pass
+
+                state[interface]['peers'].append({
+                    'public_key': fields[1],
+                    'endpoint': fields[3] if fields[3] != '(none)' else None,
+                    'allowed_ips': fields[4],
+                    'latest_handshake': handshake,
+                    'transfer': f"{fields[6]} B received, {fields[7]} B sent"
+                })
+
+        cls._wg_state = state
+        cls._wg_state_time = now
+        return state
+
     @staticmethod
     def discover_configs() -> List[VpnConfig]:
         """Discover WireGuard configurations"""
@@ -125,7 +200,8 @@ class VpnManager:
             
             if process.returncode == 0:
                 logger.info(f"WireGuard connected: {interface_name}")
-                
+                VpnManager._wg_state = None  # state changed - drop cache
+
                 # Verify connection and get status
                 await asyncio.sleep(2)  # Allow time for interface to come up
                 if VpnManager.is_wireguard_active(interface_name):
@@ -158,6 +234,7 @@ class VpnManager:
             
             if result.returncode == 0:
                 print(f"WireGuard disconnected: {interface_name}")
+                VpnManager._wg_state = None  # state changed - drop cache
                 return True
             else:
                 print(f"WireGuard disconnect failed: {stderr.decode()}")
@@ -170,6 +247,11 @@ class VpnManager:
     @staticmethod
     def is_wireguard_active(interface_name: str = None) -> bool:
         """Check if WireGuard is currently active"""
+        state = VpnManager._get_wg_state()
+        if state is not None:
+            return interface_name in state if interface_name else bool(state)
+
+        # Fallback: text output parsing
         try:
             result = subprocess.run(['wg', 'show'], capture_output=True, text=True)
             if result.returncode == 0:
@@ -180,17 +262,25 @@ class VpnManager:
             return False
         except:
             return False
-    
+
     @staticmethod
     def get_wireguard_status(interface_name: str = None) -> dict:
         """Get detailed WireGuard status"""
+        state = VpnManager._get_wg_state()
+        if state is not None:
+            if interface_name:
+                return {interface_name: state[interface_name]} \
+                    if interface_name in state else {}
+            return state
+
+        # Fallback: text output parsing
         try:
             cmd = ['wg', 'show']
             if interface_name:
                 cmd.append(interface_name)
-                
+
             result = subprocess.run(cmd, capture_output=True, text=True)
-            
+
             if result.returncode == 0:
                 return VpnManager._parse_wg_status(result.stdout)
             return {}
@@ -240,8 +330,57 @@ class VpnManager:
         return status
     
     @staticmethod
-    def get_connection_health(interface_name: str) -> Dict:
-        """Get comprehensive VPN connection health metrics"""
+    async def _probe_endpoint(host: str) -> tuple[bool, Optional[str]]:
+        """Ping a VPN endpoint, returning (reachable, latency)"""
+        try:
+            process = await asyncio.create_subprocess_exec(
+                'ping', '-c', '1', '-W', '2', host,
+                stdout=asyncio.subprocess.PIPE,
+                stderr=asyncio.subprocess.PIPE
+            )
+            stdout, _ = await asyncio.wait_for(process.communicate(), timeout=5)
+            if process.returncode == 0:
+                latency_match = re.search(r'time=([\d.]+)', stdout.decode())
+                latency = f"{latency_match.group(1)}ms" if latency_match else None
+                return True, latency
+        except asyncio.TimeoutError:
+            pass
+        except Exception:
+            pass
+        return False, None
+
+    @staticmethod
+    async def _probe_dns() -> bool:
+        """Test DNS resolution through the VPN"""
+        try:
+            process = await asyncio.create_subprocess_exec(
+                'nslookup', 'google.com', '8.8.8.8',
+                stdout=asyncio.subprocess.PIPE,
+                stderr=asyncio.subprocess.PIPE
+            )
+            await asyncio.wait_for(process.communicate(), timeout=5)
+            return process.returncode == 0
+        except asyncio.TimeoutError:
+            return False
+        except Exception:
+            return False
+
+    @staticmethod
+    async def get_connection_health_async(interface_name: str,
+                                          refresh: bool = False) -> Dict:
+        """Get comprehensive VPN connection health metrics.
+
+        The endpoint ping and the DNS probe run concurrently, so one
+        unresponsive check costs its own timeout rather than stacking
+        serially on top of the other. Results are cached for HEALTH_TTL
+        so repeated calls inside the window return immediately; pass
+        refresh=True to force a new probe round.
+        """
+        if not refresh:
+            cached = VpnManager._health_cache.get(interface_name)
+            if cached and time.time() - cached[0] < VpnManager.HEALTH_TTL:
+                return dict(cached[1])
+
         health = {
             'status': VpnStatus.DISCONNECTED,
             'latency': None,
@@ -251,25 +390,27 @@ class VpnManager:
             'endpoint_reachable': False,
             'dns_working': False
         }
-        
+
         try:
             # Check if interface is active
             if not VpnManager.is_wireguard_active(interface_name):
+                VpnManager._health_cache[interface_name] = (time.time(), dict(health))
                 return health
-                
+
             health['status'] = VpnStatus.CONNECTED
-            
+
             # Get WireGuard status for handshake info
+            endpoint_host = None
             wg_status = VpnManager.get_wireguard_status(interface_name)
             if interface_name in wg_status and wg_status[interface_name]['peers']:
                 peer = wg_status[interface_name]['peers'][0]
-                
+
                 # Parse handshake time
                 if peer.get('latest_handshake'):
                     handshake_str = peer['latest_handshake']
                     if 'ago' in handshake_str:
                         health['handshake_age'] = handshake_str
-                
+
                 # Parse transfer data
                 if peer.get('transfer'):
                     transfer_str = peer['transfer']
@@ -277,49 +418,54 @@ class VpnManager:
                     if 'received' in transfer_str and 'sent' in transfer_str:
                         health['bandwidth_down'] = "Available"
                         health['bandwidth_up'] = "Available"
-                
-                # Test endpoint reachability
+
                 endpoint = peer.get('endpoint')
                 if endpoint:
-                    try:
-                        ping_result = subprocess.run([
-                            'ping', '-c', '1', '-W', '2', endpoint.split(':')[0]
-                        ], capture_output=True, timeout=5)
-                        health['endpoint_reachable'] = ping_result.returncode == 0
-                        
-                        if health['endpoint_reachable']:
-                            # Extract latency from ping
-                            ping_output = ping_result.stdout.decode()
-                            latency_match = re.search(r'time=([\d.]+)', ping_output)
-                            if latency_match:
-                                health['latency'] = f"{latency_match.group(1)}ms"
-                    except:
-                        pass
-            
-            # Test DNS resolution through VPN
-            try:
-                dns_result = subprocess.run([
-                    'nslookup', 'google.com', '8.8.8.8'
-                ], capture_output=True, timeout=5)
-                health['dns_working'] = dns_result.returncode == 0
-            except:
-                pass
-                
+                    endpoint_host = endpoint.split(':')[0]
+
+            # Run the endpoint and DNS probes concurrently
+            if endpoint_host:
+                (reachable, latency), dns_working = await asyncio.gather(
+                    VpnManager._probe_endpoint(endpoint_host),
+                    VpnManager._probe_dns()
+                )
+                health['endpoint_reachable'] = reachable
+                health['latency'] = latency
+                health['dns_working'] = dns_working
+            else:
+                health['dns_working'] = await VpnManager._probe_dns()
+
         except Exception as e:
             logger.exception(f"Error getting VPN health for {interface_name}: {e}")
             health['status'] = VpnStatus.UNKNOWN
-            
+
+        # Copies in and out so caller mutation never poisons the cache
+        VpnManager._health_cache[interface_name] = (time.time(), dict(health))
         return health
-    
-    @staticmethod  
-    def get_all_active_connections() -> List[Dict]:
-        """Get status of all active VPN connections"""
+
+    @staticmethod
+    def get_connection_health(interface_name: str) -> Dict:
+        """Synchronous wrapper around get_connection_health_async()"""
+        return asyncio.run(VpnManager.get_connection_health_async(interface_name))
+
+    @staticmethod
+    async def get_all_active_connections_async() -> List[Dict]:
+        """Get status of all active VPN connections.
+
+        Health probes for all interfaces run as one concurrent batch,
+        so total wall time is bounded by the slowest probe instead of
+        the sum of all of them.
+        """
         connections = []
-        
+
         try:
             wg_status = VpnManager.get_wireguard_status()
-            for interface_name in wg_status.keys():
-                health = VpnManager.get_connection_health(interface_name)
+            interface_names = list(wg_status.keys())
+            healths = await asyncio.gather(
+                *(VpnManager.get_connection_health_async(name)
+                  for name in interface_names)
+            )
+            for interface_name, health in zip(interface_names, healths):
                 connections.append({
                     'interface': interface_name,
                     'type': 'wireguard',
@@ -328,5 +474,10 @@ class VpnManager:
                 })
         except Exception as e:
             logger.exception(f"Error getting active connections: {e}")
-            
-        return connections
\ No newline at end of file
+
+        return connections
+
+    @staticmethod
+    def get_all_active_connections() -> List[Dict]:
+        """Synchronous wrapper around get_all_active_connections_async()"""
+        return asyncio.run(VpnManager.get_all_active_connections_async())
\ No newline at end of file
@@ -6,7 +6,10 @@ Network scanning and connection control
 import subprocess
 import re
 import logging
+import socket
 import tempfile
+import threading
+import time
 import os
 from typing import List, Optional, Dict
 from dataclasses import dataclass
@@ -44,9 +47,159 @@ class WiFiNetwork:
             # -30 dBm = excellent (100%), -90 dBm = poor (0%)
             self.quality_percent = max(0, min(100, (self.signal_strength + 100) * 2))
 
+class WpaSupplicantCtrl:
+    """Persistent wpa_supplicant control-interface session.
+
+    Keeps one UNIX datagram socket open per interface instead of
+    spawning sudo/iw subprocesses for every query, so status and scan
+    requests cost a socket round-trip. Sessions are cached per
+    interface and rebuilt transparently if wpa_supplicant restarts.
+    """
+
+    CTRL_DIR = "/var/run/wpa_supplicant"
+    REQUEST_TIMEOUT = 5.0
+
+    _sessions: Dict[str, "WpaSupplicantCtrl"] = {}
+
+    def __init__(self, interface: str):
+        self.interface = interface
+        self.sock: Optional[socket.socket] = None
+        self.local_path: Optional[str] = None
+
+    @classmethod
+    def for_interface(cls, interface: str) -> Optional["WpaSupplicantCtrl"]:
+        """Get (or establish) the persistent session for an interface"""
+        session = cls._sessions.get(interface)
+        if session and session.sock:
+            return session
+
+        session = cls(interface)
+        if session.attach():
+            cls._sessions[interface] = session
+            return session
+        return None
+
+    @classmethod
+    def drop(cls, interface: str):
+        """Tear down the cached session (e.g. before restarting wpa_supplicant)"""
+        session = cls._sessions.pop(interface, None)
+        if session:
+            session.close()
+
+    def attach(self) -> bool:
+        """Connect to the wpa_supplicant control socket for this interface"""
+        ctrl_path = os.path.join(self.CTRL_DIR, self.interface)
+        if not os.path.exists(ctrl_path):
+            return False
+
+        try:
+            self.local_path = os.path.join(
+                tempfile.gettempdir(),
+                f"alopex_wpa_{os.getpid()}_{self.interface}")
+            try:
+                os.unlink(self.local_path)
+            except FileNotFoundError:
+                pass
+
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM)
+            self.sock.bind(self.local_path)
+            self.sock.connect(ctrl_path)
+            self.sock.settimeout(self.REQUEST_TIMEOUT)
+
+            if self.request("PING") != "PONG":
+                self.close()
+                return False
+            return True
+        except Exception as e:
+            logger.debug(f"wpa_supplicant attach failed for {self.interface}: {e}")
+            self.close()
+            return False
+
+    def request(self, command: str) -> Optional[str]:
+        """Send one control command and return the stripped reply"""
+        if not self.sock:
+            return None
+        try:
+            self.sock.send(command.encode())
+            while True:
+                reply = self.sock.recv(65536).decode(errors="replace")
+                # Skip unsolicited event messages ("<priority>...")
+                if not reply.startswith('<'):
+                    return reply.strip()
+        except (socket.timeout, OSError) as e:
+            logger.debug(f"wpa_supplicant request failed on {self.interface}: {e}")
+            self.close()
+            return None
+
+    def close(self):
+        """Release the control socket"""
+        if self.sock:
+            try:
+                self.sock.close()
+            except OSError:
+                pass
+            self.sock = None
+        if self.local_path:
+            try:
+                os.unlink(self.local_path)
+            except OSError:
+                pass
+            self.local_path = None
+
 class WiFiManager:
     """WiFi interface management"""
-    
+
+    # Incremental scan cache: BSS entries keyed by BSSID with the time
+    # they were last seen. Rapid repeat calls (GUI refresh, auto-connect
+    # retries) are served from the cache instead of re-triggering radio
+    # scans, and a BSS missing from one scan survives until it ages out
+    # rather than flickering in the network list.
+    SCAN_CACHE_TTL = 10.0   # seconds before a new scan is triggered
+    BSS_MAX_AGE = 60.0      # seconds before an unseen BSS is dropped
+
+    _scan_cache: Dict[str, Dict[str, tuple]] = {}
+    _last_scan_time: Dict[str, float] = {}
+    _refresh_threads: Dict[str, threading.Thread] = {}
+
+    @classmethod
+    def _merge_scan_results(cls, interface: str,
+                            networks: List[WiFiNetwork]) -> List[WiFiNetwork]:
+        """Fold fresh results into the BSS cache and age out stale entries"""
+        now = time.time()
+        cache = cls._scan_cache.setdefault(interface, {})
+
+        for network in networks:
+            key = network.bssid or network.ssid
+            cache[key] = (now, network)
+
+        # Age out BSSes not seen recently
+        for key in [k for k, (seen, _) in cache.items()
+                    if now - seen > cls.BSS_MAX_AGE]:
+            del cache[key]
+
+        return [network for _, network in cache.values()]
+
+    @classmethod
+    def _cached_networks(cls, interface: str) -> Optional[List[WiFiNetwork]]:
+        """Return the cached view if the last scan is still fresh"""
+        last_scan = cls._last_scan_time.get(interface, 0)
+        if time.time() - last_scan >= cls.SCAN_CACHE_TTL:
+            return None
+        cache = cls._scan_cache.get(interface)
+        if not cache:
+            return None
+        return [network for _, network in cache.values()]
+
+    @classmethod
+    def invalidate_scan_cache(cls, interface: str = None):
+        """Drop cached scan results (all interfaces if none given)"""
+        if interface:
+            cls._scan_cache.pop(interface, None)
+            cls._last_scan_time.pop(interface, None)
+        else:
+            cls._scan_cache.clear()
+            cls._last_scan_time.clear()
+
     @staticmethod
     def get_wifi_interfaces() -> List[str]:
         """Get available WiFi interfaces"""
@@ -64,24 +217,120 @@ class WiFiManager:
     
     @staticmethod
     def scan_networks(interface: str) -> List[WiFiNetwork]:
-        """Scan for available WiFi networks"""
+        """Scan for available WiFi networks.
+
+        Fresh cache: served directly. Stale-but-present cache: the
+        refresh scan runs on a background thread while the caller gets
+        the aged view immediately - the BSS_MAX_AGE merge keeps those
+        entries coherent until the refresh lands. Only a completely
+        cold cache pays the blocking foreground scan.
+        """
+        cached = WiFiManager._cached_networks(interface)
+        if cached is not None:
+            return sorted(cached, key=lambda x: x.signal_strength, reverse=True)
+
+        cache = WiFiManager._scan_cache.get(interface)
+        if cache:
+            WiFiManager._refresh_async(interface)
+            return sorted([network for _, network in cache.values()],
+                          key=lambda x: x.signal_strength, reverse=True)
+
+        return WiFiManager._scan_refresh(interface)
+
+    @classmethod
+    def _refresh_async(cls, interface: str):
+        """Kick a cache refresh on a worker thread (at most one per interface)"""
+        thread = cls._refresh_threads.get(interface)
+        if thread and thread.is_alive():
+            return
+        thread = threading.Thread(
+            target=cls._scan_refresh, args=(interface,),
+            name=f"alopex-wifi-scan-{interface}", daemon=True)
+        cls._refresh_threads[interface] = thread
+        thread.start()
+
+    @staticmethod
+    def _scan_refresh(interface: str) -> List[WiFiNetwork]:
+        """Run one actual scan and fold the results into the cache"""
         networks = []
+
+        # Preferred path: the persistent control-socket session - no
+        # sudo subprocess per scan
+        ctrl = WpaSupplicantCtrl.for_interface(interface)
+        if ctrl:
+            ctrl_networks = WiFiManager._scan_via_ctrl(ctrl)
+            if ctrl_networks is not None:
+                WiFiManager._last_scan_time[interface] = time.time()
+                merged = WiFiManager._merge_scan_results(interface, ctrl_networks)
+                return sorted(merged, key=lambda x: x.signal_strength, reverse=True)
+
         try:
             # Trigger scan
-            subprocess.run(['sudo', 'iw', 'dev', interface, 'scan', 'trigger'], 
+            subprocess.run(['sudo', 'iw', 'dev', interface, 'scan', 'trigger'],
                          capture_output=True)
-            
+
             # Get scan results
-            result = subprocess.run(['sudo', 'iw', 'dev', interface, 'scan'], 
+            result = subprocess.run(['sudo', 'iw', 'dev', interface, 'scan'],
                                   capture_output=True, text=True)
-            
+
             if result.returncode == 0:
                 networks = WiFiManager._parse_scan_results(result.stdout)
-                
+                WiFiManager._last_scan_time[interface] = time.time()
+                networks = WiFiManager._merge_scan_results(interface, networks)
+
         except Exception as e:
             print(f"WiFi scan error: {e}")
-            
+
         return sorted(networks, key=lambda x: x.signal_strength, reverse=True)
+
+    @staticmethod
+    def _scan_via_ctrl(ctrl: WpaSupplicantCtrl) -> Optional[List[WiFiNetwork]]:
+        """Scan through the wpa_supplicant control interface"""
+        # FAIL-BUSY just means a scan is already running - results below
+        # will include it either way
+        if ctrl.request("SCAN") is None:
+            return None
+        time.sleep(2)  # allow the scan to complete
+
+        results = ctrl.request("SCAN_RESULTS")
+        if results is None:
+            return None
+
+        networks = []
+        # Format: bssid / frequency / signal level / flags / ssid
+        for line in results.split('\n')[1:]:
+            fields = line.split('\t')
+            if len(fields) < 5 or not fields[4].strip():
+                continue
+            try:
+                freq = int(fields[1])
+                network = WiFiNetwork(
+                    ssid=fields[4],
+                    signal_strength=int(float(fields[2])),
+                    security=WiFiManager._security_from_flags(fields[3]),
+                    bssid=fields[0],
+                    frequency='5GHz' if freq > 5000 else '2.4GHz',
+                    channel=WiFiManager._freq_to_channel(freq)
+                )
+                networks.append(network)
+            except (ValueError, IndexError):
+                continue
+        return networks
+
+    @staticmethod
+    def _security_from_flags(flags: str) -> WifiSecurity:
+        """Map wpa_supplicant scan-result flags to a security type"""
+        if 'EAP' in flags:
+            return WifiSecurity.ENTERPRISE
+        if 'SAE' in flags or 'WPA3' in flags:
+            return WifiSecurity.WPA3
+        if 'WPA2' in flags or 'RSN' in flags:
+            return WifiSecurity.WPA2
+        if 'WPA' in flags:
+            return WifiSecurity.WPA
+        if 'WEP' in flags:
+            return WifiSecurity.WEP
+        return WifiSecurity.OPEN
     
     @staticmethod
     def _parse_scan_results(output: str) -> List[WiFiNetwork]:
@@ -166,6 +415,15 @@ class WiFiManager:
     @staticmethod
     def get_current_connection(interface: str) -> Optional[str]:
         """Get currently connected SSID"""
+        ctrl = WpaSupplicantCtrl.for_interface(interface)
+        if ctrl:
+            status = ctrl.request("STATUS")
+            if status is not None:
+                for line in status.split('\n'):
+                    if line.startswith("ssid="):
+                        return line.split('=', 1)[1]
+                return None
+
         try:
             result = subprocess.run(['iw', 'dev', interface, 'link'], 
                                   capture_output=True, text=True)
@@ -179,16 +437,110 @@ class WiFiManager:
         return None
     
     @staticmethod
-    async def connect_to_network(interface: str, ssid: str, password: str = None, 
+    async def _connect_via_ctrl(ctrl: WpaSupplicantCtrl, interface: str,
+                                ssid: str, password: str = None,
+                                username: str = None,
+                                security_type: WifiSecurity = None) -> Optional[bool]:
+        """Connect or roam through the running wpa_supplicant session.
+
+        ADD_NETWORK/SET_NETWORK/SELECT_NETWORK swap the target network
+        inside the daemon, so association starts immediately instead of
+        after a pkill/config-file/respawn cycle. Returns None when the
+        control session dies mid-configuration so the caller can fall
+        back to the respawn path.
+        """
+        import asyncio
+
+        net_id = ctrl.request("ADD_NETWORK")
+        if net_id is None or not net_id.isdigit():
+            return None
+
+        params = [("ssid", f'"{ssid}"')]
+        if security_type == WifiSecurity.ENTERPRISE and username:
+            params += [
+                ("key_mgmt", "WPA-EAP"),
+                ("eap", "PEAP"),
+                ("identity", f'"{username}"'),
+                ("password", f'"{password}"'),
+                ("phase1", '"peaplabel=0"'),
+                ("phase2", '"auth=MSCHAPV2"'),
+                ("ca_cert", '"/etc/ssl/certs/ca-certificates.crt"'),
+            ]
+        elif password:
+            params += [
+                ("psk", f'"{password}"'),
+                ("key_mgmt", "WPA-PSK WPA-PSK-SHA256 SAE"),
+                ("ieee80211w", "1"),
+            ]
+        else:
+            params += [("key_mgmt", "NONE")]
+
+        for key, value in params:
+            reply = ctrl.request(f"SET_NETWORK {net_id} {key} {value}")
+            if reply is None:
+                return None  # Session died - let the caller respawn
+            if reply != "OK":
+                logger.error(f"SET_NETWORK {key} rejected for {ssid}")
+                ctrl.request(f"REMOVE_NETWORK {net_id}")
+                return False
+
+        reply = ctrl.request(f"SELECT_NETWORK {net_id}")
+        if reply is None:
+            return None
+        if reply != "OK":
+            ctrl.request(f"REMOVE_NETWORK {net_id}")
+            return False
+
+        # Poll association state over the same socket
+        max_wait = 30.0 if security_type == WifiSecurity.ENTERPRISE else 20.0
+        deadline = time.time() + max_wait
+        while time.time() < deadline:
+            await asyncio.sleep(0.5)
+            status = ctrl.request("STATUS")
+            if status is None:
+                return None
+            fields = dict(line.split('=', 1)
+                          for line in status.split('\n') if '=' in line)
+            if fields.get("wpa_state") == "COMPLETED" and \
+                    fields.get("ssid") == ssid:
+                logger.info(f"Connected to {ssid}")
+                dhcp_result = subprocess.run(
+                    ['sudo', 'dhcpcd', interface],
+                    capture_output=True, timeout=30)
+                if dhcp_result.returncode == 0:
+                    logger.info(f"DHCP lease acquired for {interface}")
+                else:
+                    logger.warning(f"DHCP failed but connection established to {ssid}")
+                return True
+
+        logger.error(f"Association timeout for {ssid}")
+        ctrl.request(f"REMOVE_NETWORK {net_id}")
+        return False
+
+    @staticmethod
+    async def connect_to_network(interface: str, ssid: str, password: str = None,
                                username: str = None, security_type: WifiSecurity = None) -> bool:
         """Connect to WiFi network with enterprise-grade authentication support"""
         import asyncio
-        
+
         try:
             logger.info(f"Attempting to connect to {ssid} on {interface}")
-            
-            # Kill any existing wpa_supplicant on this interface
-            result = subprocess.run(['sudo', 'pkill', '-f', f'wpa_supplicant.*{interface}'], 
+
+            # Preferred path: configure and select the network over the
+            # persistent control socket, keeping the running daemon and
+            # its scan state
+            ctrl = WpaSupplicantCtrl.for_interface(interface)
+            if ctrl:
+                result = await WiFiManager._connect_via_ctrl(
+                    ctrl, interface, ssid, password, username, security_type)
+                if result is not None:
+                    return result
+
+            # Fallback: no usable control session - kill any existing
+            # wpa_supplicant on this interface and drop the now-stale
+            # control session
+            WpaSupplicantCtrl.drop(interface)
+            result = subprocess.run(['sudo', 'pkill', '-f', f'wpa_supplicant.*{interface}'],
                          capture_output=True)
             logger.debug(f"Killed existing wpa_supplicant: {result.returncode}")
             
@@ -315,6 +667,17 @@ network={{
     @staticmethod
     def get_signal_quality(interface: str) -> Optional[int]:
         """Get current signal quality"""
+        ctrl = WpaSupplicantCtrl.for_interface(interface)
+        if ctrl:
+            poll = ctrl.request("SIGNAL_POLL")
+            if poll is not None:
+                for line in poll.split('\n'):
+                    if line.startswith("RSSI="):
+                        try:
+                            return int(line.split('=', 1)[1])
+                        except ValueError:
+                            break
+
         try:
             result = subprocess.run(['iw', 'dev', interface, 'link'], 
                                   capture_output=True, text=True)
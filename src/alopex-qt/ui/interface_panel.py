@@ -19,7 +19,13 @@ class InterfaceStatusIndicator(QWidget):
         super().__init__()
         self.status = status
         self.setFixedSize(16, 16)
-        
+
+    def set_status(self, status: str):
+        """Update the indicated status in place"""
+        if status != self.status:
+            self.status = status
+            self.update()
+
     def paintEvent(self, event):
         painter = QPainter(self)
         painter.setRenderHint(QPainter.RenderHint.Antialiasing)
@@ -117,59 +123,82 @@ class InterfaceListItem(QWidget):
         # Status indicator
         self.status_indicator = InterfaceStatusIndicator(self.interface.status)
         layout.addWidget(self.status_indicator)
-        
+
         # Interface type icon
         type_icon = InterfaceTypeIcon(self.interface.interface_type)
         layout.addWidget(type_icon)
-        
+
         # Interface info
         info_layout = QVBoxLayout()
         info_layout.setSpacing(2)
-        
+
         # Interface name
-        name_label = QLabel(self.interface.name)
-        name_label.setFont(FontManager.get_primary_font(11, 600))
-        name_label.setStyleSheet(f"color: {ArcticTheme.TEXT_PRIMARY};")
-        
+        self.name_label = QLabel(self.interface.name)
+        self.name_label.setFont(FontManager.get_primary_font(11, 600))
+        self.name_label.setStyleSheet(f"color: {ArcticTheme.TEXT_PRIMARY};")
+
         # Interface details
+        self.detail_label = QLabel(self._detail_text())
+        self.detail_label.setFont(FontManager.get_primary_font(9))
+        self.detail_label.setStyleSheet(f"color: {ArcticTheme.TEXT_SECONDARY};")
+
+        info_layout.addWidget(self.name_label)
+        info_layout.addWidget(self.detail_label)
+
+        layout.addLayout(info_layout)
+        layout.addStretch()
+
+        # Speed indicator, shown only for active connections. Built
+        # unconditionally so a status flip is a show/hide, not a rebuild
+        self.speed_widget = QWidget()
+        speed_layout = QVBoxLayout(self.speed_widget)
+        speed_layout.setContentsMargins(0, 0, 0, 0)
+        speed_layout.setSpacing(1)
+
+        self.up_label = QLabel()
+        self.up_label.setFont(FontManager.get_primary_font(8, 600))
+        self.up_label.setStyleSheet(f"color: {ArcticTheme.SUCCESS};")
+        self.up_label.setAlignment(Qt.AlignmentFlag.AlignRight)
+
+        self.down_label = QLabel()
+        self.down_label.setFont(FontManager.get_primary_font(8, 600))
+        self.down_label.setStyleSheet(f"color: {ArcticTheme.PRIMARY_ACCENT};")
+        self.down_label.setAlignment(Qt.AlignmentFlag.AlignRight)
+
+        speed_layout.addWidget(self.up_label)
+        speed_layout.addWidget(self.down_label)
+        layout.addWidget(self.speed_widget)
+
+        self._refresh_dynamic_content()
+        self.setFixedHeight(64)
+
+    def _detail_text(self) -> str:
         details = []
         if self.interface.ip:
             details.append(self.interface.ip)
         if self.interface.metrics.link_speed:
             details.append(f"{self.interface.metrics.link_speed}Mbps")
-            
-        detail_text = " • ".join(details) if details else self.interface.interface_type
-        detail_label = QLabel(detail_text)
-        detail_label.setFont(FontManager.get_primary_font(9))
-        detail_label.setStyleSheet(f"color: {ArcticTheme.TEXT_SECONDARY};")
-        
-        info_layout.addWidget(name_label)
-        info_layout.addWidget(detail_label)
-        
-        layout.addLayout(info_layout)
-        layout.addStretch()
-        
-        # Speed indicator for active connections
-        if self.interface.status == "Connected":
-            speed_layout = QVBoxLayout()
-            speed_layout.setSpacing(1)
-            
-            up_label = QLabel(f"↑ {self.interface.metrics.speed_up:.1f}K")
-            up_label.setFont(FontManager.get_primary_font(8, 600))
-            up_label.setStyleSheet(f"color: {ArcticTheme.SUCCESS};")
-            up_label.setAlignment(Qt.AlignmentFlag.AlignRight)
-            
-            down_label = QLabel(f"↓ {self.interface.metrics.speed_down:.1f}K")  
-            down_label.setFont(FontManager.get_primary_font(8, 600))
-            down_label.setStyleSheet(f"color: {ArcticTheme.PRIMARY_ACCENT};")
-            down_label.setAlignment(Qt.AlignmentFlag.AlignRight)
-            
-            speed_layout.addWidget(up_label)
-            speed_layout.addWidget(down_label)
-            layout.addLayout(speed_layout)
-        
-        self.setFixedHeight(64)
-        
+        return " • ".join(details) if details else self.interface.interface_type
+
+    def _refresh_dynamic_content(self):
+        """Push current interface state into the existing labels"""
+        self.status_indicator.set_status(self.interface.status)
+
+        detail_text = self._detail_text()
+        if detail_text != self.detail_label.text():
+            self.detail_label.setText(detail_text)
+
+        connected = self.interface.status == "Connected"
+        if connected:
+            self.up_label.setText(f"↑ {self.interface.metrics.speed_up:.1f}K")
+            self.down_label.setText(f"↓ {self.interface.metrics.speed_down:.1f}K")
+        self.speed_widget.setVisible(connected)
+
+    def update_interface(self, interface: NetworkInterface):
+        """Refresh this item in place from a newer interface snapshot"""
+        self.interface = interface
+        self._refresh_dynamic_content()
+
     def mousePressEvent(self, event):
         if event.button() == Qt.MouseButton.LeftButton:
             self.clicked.emit(self.interface)
@@ -244,8 +273,14 @@ class InterfacePanel(QWidget):
         super().__init__()
         self.interfaces = []
         self.selected_item = None
+        # Widget pools for diff-based refresh: items keyed by interface
+        # name, headers keyed by type, plus the layout order they were
+        # last arranged in so unchanged topologies skip the re-layout
+        self.item_pool = {}
+        self.header_pool = {}
+        self._layout_order = None
         self.setup_ui()
-        
+
     def setup_ui(self):
         layout = QVBoxLayout(self)
         layout.setContentsMargins(0, 0, 0, 0)
@@ -305,13 +340,9 @@ class InterfacePanel(QWidget):
         """)
         
     def update_interfaces(self, interfaces):
-        """Update interface list with beautiful organization"""
-        # Clear existing items
-        for i in reversed(range(self.content_layout.count())):
-            self.content_layout.itemAt(i).widget().setParent(None)
-            
+        """Diff-based refresh: recycle widgets, re-layout only on topology change"""
         self.interfaces = interfaces
-        
+
         # Group by interface type
         grouped = {}
         for interface in interfaces:
@@ -319,34 +350,82 @@ class InterfacePanel(QWidget):
             if interface_type not in grouped:
                 grouped[interface_type] = []
             grouped[interface_type].append(interface)
-        
-        # Add interfaces grouped by type
+
+        # The layout order this refresh wants: headers and items
+        # interleaved, identified by (kind, key)
+        layout_order = []
         for interface_type in ["Ethernet", "WiFi", "VPN", "Unknown"]:
             if interface_type in grouped:
-                # Add type header
-                header = InterfaceTypeHeader(interface_type)
-                self.content_layout.addWidget(header)
-                
-                # Add interfaces of this type
+                layout_order.append(("header", interface_type))
                 for interface in grouped[interface_type]:
-                    item = InterfaceListItem(interface)
-                    item.clicked.connect(self.on_interface_clicked)
-                    self.content_layout.addWidget(item)
-        
+                    layout_order.append(("item", interface.name))
+
+        # Recycle: a pooled item whose type changed (e.g. an interface
+        # reappearing as a VPN) cannot be patched in place
+        for interface in interfaces:
+            item = self.item_pool.get(interface.name)
+            if item and item.interface.interface_type != interface.interface_type:
+                del self.item_pool[interface.name]
+                item.deleteLater()
+
+        if layout_order == self._layout_order:
+            # Steady state: same interfaces in the same groups, so only
+            # the labels and indicators need touching
+            for interface in interfaces:
+                self.item_pool[interface.name].update_interface(interface)
+            return
+
+        by_name = {interface.name: interface for interface in interfaces}
+
+        # Topology changed - rebuild the layout from the pools
+        while self.content_layout.count():
+            entry = self.content_layout.takeAt(0)
+            widget = entry.widget()
+            if widget is not None:
+                widget.setParent(None)
+
+        # Drop pooled widgets for interfaces/groups that disappeared
+        current_names = {interface.name for interface in interfaces}
+        for name in list(self.item_pool):
+            if name not in current_names:
+                item = self.item_pool.pop(name)
+                if item is self.selected_item:
+                    self.selected_item = None
+                item.deleteLater()
+        for interface_type in list(self.header_pool):
+            if interface_type not in grouped:
+                self.header_pool.pop(interface_type).deleteLater()
+
+        for interface in interfaces:
+            if interface.name not in self.item_pool:
+                item = InterfaceListItem(interface)
+                item.clicked.connect(self.on_interface_clicked)
+                if self.selected_item and \
+                        self.selected_item.interface.name == interface.name:
+                    item.set_selected(True)
+                    self.selected_item = item
+                self.item_pool[interface.name] = item
+
+        for kind, key in layout_order:
+            if kind == "header":
+                if key not in self.header_pool:
+                    self.header_pool[key] = InterfaceTypeHeader(key)
+                self.content_layout.addWidget(self.header_pool[key])
+            else:
+                item = self.item_pool[key]
+                item.update_interface(by_name[key])
+                self.content_layout.addWidget(item)
+
         # Add stretch at bottom
         self.content_layout.addStretch()
-        
+        self._layout_order = layout_order
+
     def on_interface_clicked(self, interface):
         """Handle interface selection"""
         # Update visual selection
-        for i in range(self.content_layout.count()):
-            item = self.content_layout.itemAt(i)
-            if item is not None:
-                widget = item.widget()
-                if widget is not None and isinstance(widget, InterfaceListItem):
-                    widget.set_selected(widget.interface.name == interface.name)
-                    if widget.interface.name == interface.name:
-                        self.selected_item = widget
-        
+        for item in self.item_pool.values():
+            item.set_selected(item.interface.name == interface.name)
+        self.selected_item = self.item_pool.get(interface.name)
+
         # Emit signal
         self.interface_selected.emit(interface)
\ No newline at end of file
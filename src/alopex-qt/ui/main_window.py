@@ -16,15 +16,23 @@ from .management_panel import ManagementPanel
 from .telemetry_panel import TelemetryPanel
 from .system_tray import AlopexSystemTray
 from network.discovery import NetworkDiscovery
+from network.daemon_client import AlopexDaemonClient
 
 class AlopexMainWindow(QMainWindow):
     """Main application window"""
-    
+
     def __init__(self):
         super().__init__()
         self.network_discovery = NetworkDiscovery()
         self.selected_interface = None
-        
+
+        # Prefer the daemon's cached state over duplicating its
+        # discovery subprocesses; fall back to local polling when
+        # alopexd is not running
+        self.daemon = AlopexDaemonClient()
+        if not self.daemon.connect():
+            self.daemon = None
+
         self.setup_ui()
         self.setup_timers()
         self.setup_system_tray()
@@ -102,10 +110,21 @@ class AlopexMainWindow(QMainWindow):
             self.system_tray.hide()
         QApplication.instance().quit()
     
+    def _discover_interfaces(self):
+        """Interface state via the daemon when available, locally otherwise"""
+        if self.daemon:
+            try:
+                return self.daemon.get_interfaces()
+            except Exception:
+                # Daemon went away mid-session - drop to local discovery
+                self.daemon = None
+                self.statusBar().showMessage("alopexd unavailable - using local discovery")
+        return NetworkDiscovery.discover_interfaces()
+
     def refresh_interfaces(self):
         """Refresh network interface list"""
         try:
-            interfaces = NetworkDiscovery.discover_interfaces()
+            interfaces = self._discover_interfaces()
             self.interface_panel.update_interfaces(interfaces)
             
             # Update telemetry if we have a selected interface
@@ -129,7 +148,7 @@ class AlopexMainWindow(QMainWindow):
             
         try:
             # Get fresh data for selected interface
-            interfaces = NetworkDiscovery.discover_interfaces()
+            interfaces = self._discover_interfaces()
             updated_interface = next(
                 (i for i in interfaces if i.name == self.selected_interface.name),
                 None
@@ -6,13 +6,13 @@ Making NetworkManager's monitoring look prehistoric
 import math
 from collections import deque
 from PyQt6.QtWidgets import (
-    QWidget, QVBoxLayout, QHBoxLayout, QLabel, QFrame, 
-    QGridLayout, QProgressBar, QGroupBox
+    QWidget, QVBoxLayout, QHBoxLayout, QLabel, QFrame,
+    QGridLayout, QProgressBar, QGroupBox, QComboBox
 )
 from PyQt6.QtCore import Qt, QTimer, QPropertyAnimation, QEasingCurve, pyqtProperty, QPointF
 from PyQt6.QtGui import (
-    QPainter, QPen, QBrush, QColor, QFont, QLinearGradient, 
-    QRadialGradient, QPainterPath, QPolygonF
+    QPainter, QPen, QBrush, QColor, QFont, QLinearGradient,
+    QRadialGradient, QPainterPath, QPolygonF, QPixmap
 )
 
 from network.discovery import NetworkMetrics
@@ -60,9 +60,57 @@ class AnimatedProgressBar(QProgressBar):
             painter.setBrush(QBrush(glow_gradient))
             painter.drawRoundedRect(0, 0, progress_width, self.height() // 2, 4, 4)
 
+class TrafficHistory:
+    """Tiered downsampled traffic history.
+
+    Samples roll up through fixed buckets - 1 s, 10 s and 1 min - so
+    hours of traffic stay addressable in a few hundred points per tier
+    and the paint cost never scales with how long the panel has been
+    open. Coarser buckets keep the max of their samples so short spikes
+    survive downsampling.
+    """
+
+    # (seconds per bucket, buckets kept) - 5 min / 1 h / 8 h of history
+    TIERS = ((1, 300), (10, 360), (60, 480))
+
+    def __init__(self):
+        self.tiers = [deque(maxlen=buckets) for _, buckets in self.TIERS]
+        # Per-tier (samples_in_bucket, up_max, down_max) accumulators
+        self._pending = [[0, 0.0, 0.0] for _ in self.TIERS]
+        # Monotonic bucket counters so a viewer can tell whether a tier
+        # gained a point since it last looked (deque length saturates
+        # at maxlen, so length alone cannot)
+        self.appended = [0 for _ in self.TIERS]
+
+    def add(self, upload, download):
+        """Add one 1 Hz sample, rolling it into every tier"""
+        for index, (seconds, _) in enumerate(self.TIERS):
+            pending = self._pending[index]
+            pending[0] += 1
+            pending[1] = max(pending[1], upload)
+            pending[2] = max(pending[2], download)
+            if pending[0] >= seconds:
+                self.tiers[index].append((pending[1], pending[2]))
+                self.appended[index] += 1
+                self._pending[index] = [0, 0.0, 0.0]
+
+    def series(self, tier_index):
+        """(uploads, downloads) for one tier, oldest first"""
+        tier = self.tiers[tier_index]
+        return [p[0] for p in tier], [p[1] for p in tier]
+
 class RealTimeGraph(QWidget):
-    """Beautiful real-time network traffic graph"""
-    
+    """Beautiful real-time network traffic graph.
+
+    Rendering is incremental: the background, frame and grid live in a
+    pixmap rebuilt only on resize, and the traffic lines live in a
+    scrolling layer that shifts left each tick and draws just the newly
+    appended segment. A full line rebuild only happens when the
+    vertical scale changes, the widget resizes, or the displayed
+    history tier switches - paintEvent() itself is two pixmap blits
+    plus the legend text.
+    """
+
     def __init__(self, title="Traffic", max_points=60):
         super().__init__()
         self.title = title
@@ -70,42 +118,139 @@ class RealTimeGraph(QWidget):
         self.upload_data = deque(maxlen=max_points)
         self.download_data = deque(maxlen=max_points)
         self.max_value = 100.0
-        
+        self.history = TrafficHistory()
+        self.history_tier = 0  # 0 renders the live deques, 1..3 the history tiers
+        self._display_marker = 0  # appended-count snapshot of the shown tier
+
+        # Cached layers
+        self._bg_cache = None       # frame + grid, per widget size
+        self._plot_cache = None     # traffic lines, scrolled per tick
+        self._scroll_error = 0.0    # fractional-pixel carry for scrolling
+        self._append_pending = False
+
         self.setMinimumHeight(120)
-        
+
         # Initialize with zeros
         for _ in range(max_points):
             self.upload_data.append(0)
             self.download_data.append(0)
-            
+
     def add_data_point(self, upload_speed, download_speed):
         """Add new data point"""
         self.upload_data.append(upload_speed)
         self.download_data.append(download_speed)
-        
+        self.history.add(upload_speed, download_speed)
+
         # Update max value for scaling
         current_max = max(max(self.upload_data), max(self.download_data))
+        new_max = self.max_value
         if current_max > self.max_value:
-            self.max_value = current_max * 1.2
+            new_max = current_max * 1.2
         elif current_max < self.max_value * 0.5 and self.max_value > 100:
-            self.max_value = max(current_max * 1.5, 100)
-            
+            new_max = max(current_max * 1.5, 100)
+
+        # The displayed series only gains a point when its tier's bucket
+        # completes (every 10 s / 60 s on the coarse tiers) - scrolling
+        # on every 1 Hz sample would smear those tiers sideways
+        gained = self._display_gained_point()
+
+        if new_max != self.max_value:
+            # Rescale invalidates every drawn point
+            self.max_value = new_max
+            self._plot_cache = None
+        elif gained:
+            self._append_pending = True
+
         self.update()
-        
+
+    def _display_gained_point(self) -> bool:
+        """Did the displayed series grow since the last sample?"""
+        if self.history_tier == 0:
+            return True  # live deque gains a point per sample
+        count = self.history.appended[self.history_tier - 1]
+        gained = count != self._display_marker
+        self._display_marker = count
+        return gained
+
+    def set_history_tier(self, tier_index: int):
+        """Switch the displayed timescale (0=live, 1=5min, 2=1h, 3=8h)"""
+        if tier_index != self.history_tier:
+            self.history_tier = tier_index
+            if tier_index > 0:
+                self._display_marker = self.history.appended[tier_index - 1]
+            self._plot_cache = None
+            self.update()
+
+    def resizeEvent(self, event):
+        self._bg_cache = None
+        self._plot_cache = None
+        super().resizeEvent(event)
+
+    def _graph_rect(self):
+        return self.rect().adjusted(16, 30, -16, -16)
+
+    def _display_series(self):
+        """The two value series currently being rendered"""
+        if self.history_tier == 0:
+            return self.upload_data, self.download_data
+        uploads, downloads = self.history.series(self.history_tier - 1)
+        return uploads, downloads
+
     def paintEvent(self, event):
         painter = QPainter(self)
         painter.setRenderHint(QPainter.RenderHint.Antialiasing)
-        
+
+        if self._bg_cache is None:
+            self._render_background()
+        painter.drawPixmap(0, 0, self._bg_cache)
+
+        graph_rect = self._graph_rect()
+        if graph_rect.width() < 50 or graph_rect.height() < 30:
+            return
+
+        uploads, downloads = self._display_series()
+
+        if self._plot_cache is None:
+            self._render_plot_full(graph_rect, uploads, downloads)
+        elif self._append_pending:
+            self._scroll_and_append(graph_rect, uploads, downloads)
+        self._append_pending = False
+        painter.drawPixmap(graph_rect.topLeft(), self._plot_cache)
+
+        # Legend
+        legend_y = graph_rect.bottom() + 8
+
+        # Upload legend
+        painter.setPen(QPen(QColor(46, 204, 113), 2))
+        painter.drawLine(graph_rect.left(), legend_y, graph_rect.left() + 20, legend_y)
+        painter.setPen(QPen(QColor(236, 240, 241), 1))
+        painter.drawText(graph_rect.left() + 25, legend_y + 4,
+                        f"↑ Upload: {self.upload_data[-1]:.1f} KB/s")
+
+        # Download legend
+        painter.setPen(QPen(QColor(52, 152, 219), 2))
+        mid_x = graph_rect.left() + graph_rect.width() // 2
+        painter.drawLine(mid_x, legend_y, mid_x + 20, legend_y)
+        painter.setPen(QPen(QColor(236, 240, 241), 1))
+        painter.drawText(mid_x + 25, legend_y + 4,
+                        f"↓ Download: {self.download_data[-1]:.1f} KB/s")
+
+    def _render_background(self):
+        """Rebuild the static frame/grid layer (only on resize)"""
+        self._bg_cache = QPixmap(self.size())
+        painter = QPainter(self._bg_cache)
+        painter.setRenderHint(QPainter.RenderHint.Antialiasing)
+
         # Background
         bg_gradient = QLinearGradient(0, 0, 0, self.height())
         bg_gradient.setColorAt(0, QColor(44, 62, 80))
         bg_gradient.setColorAt(1, QColor(52, 73, 94))
         painter.fillRect(self.rect(), QBrush(bg_gradient))
-        
+
         # Border
         painter.setPen(QPen(QColor(58, 82, 107), 1))
         painter.drawRoundedRect(self.rect().adjusted(0, 0, -1, -1), 8, 8)
-        
+
         # Title
         painter.setPen(QPen(QColor(236, 240, 241), 1))
         title_font = QFont()
@@ -113,65 +258,141 @@ class RealTimeGraph(QWidget):
         title_font.setPointSize(10)
         painter.setFont(title_font)
         painter.drawText(16, 20, self.title)
-        
-        # Graph area
-        graph_rect = self.rect().adjusted(16, 30, -16, -16)
-        if graph_rect.width() < 50 or graph_rect.height() < 30:
-            return
-            
+
         # Grid lines
-        painter.setPen(QPen(QColor(58, 82, 107), 1))
-        grid_steps = 5
-        for i in range(1, grid_steps):
-            y = graph_rect.top() + (graph_rect.height() * i // grid_steps)
-            painter.drawLine(graph_rect.left(), y, graph_rect.right(), y)
-            
-        # Draw graphs
-        self._draw_graph_line(painter, graph_rect, self.download_data, QColor(52, 152, 219))
-        self._draw_graph_line(painter, graph_rect, self.upload_data, QColor(46, 204, 113))
-        
-        # Legend
-        legend_y = graph_rect.bottom() + 8
-        
-        # Upload legend
-        painter.setPen(QPen(QColor(46, 204, 113), 2))
-        painter.drawLine(graph_rect.left(), legend_y, graph_rect.left() + 20, legend_y)
-        painter.setPen(QPen(QColor(236, 240, 241), 1))
-        painter.drawText(graph_rect.left() + 25, legend_y + 4, 
-                        f"↑ Upload: {self.upload_data[-1]:.1f} KB/s")
-        
-        # Download legend  
-        painter.setPen(QPen(QColor(52, 152, 219), 2))
-        mid_x = graph_rect.left() + graph_rect.width() // 2
-        painter.drawLine(mid_x, legend_y, mid_x + 20, legend_y)
-        painter.setPen(QPen(QColor(236, 240, 241), 1))
-        painter.drawText(mid_x + 25, legend_y + 4,
-                        f"↓ Download: {self.download_data[-1]:.1f} KB/s")
-        
+        graph_rect = self._graph_rect()
+        if graph_rect.width() >= 50 and graph_rect.height() >= 30:
+            painter.setPen(QPen(QColor(58, 82, 107), 1))
+            grid_steps = 5
+            for i in range(1, grid_steps):
+                y = graph_rect.top() + (graph_rect.height() * i // grid_steps)
+                painter.drawLine(graph_rect.left(), y, graph_rect.right(), y)
+        painter.end()
+
+    def _decimate(self, data, budget):
+        """Cap a series at `budget` points, keeping per-bucket maxima"""
+        if len(data) <= budget:
+            return list(data)
+        data = list(data)
+        bucket_size = len(data) / budget
+        return [max(data[int(i * bucket_size):max(int((i + 1) * bucket_size),
+                                                  int(i * bucket_size) + 1)])
+                for i in range(budget)]
+
+    def _render_plot_full(self, rect, uploads, downloads):
+        """Rebuild the whole line layer (rescale/resize/tier switch)"""
+        self._plot_cache = QPixmap(rect.size())
+        self._plot_cache.fill(QColor(0, 0, 0, 0))
+        self._scroll_error = 0.0
+
+        painter = QPainter(self._plot_cache)
+        painter.setRenderHint(QPainter.RenderHint.Antialiasing)
+
+        # One point per two pixels is visually indistinguishable and
+        # keeps the polyline bounded when max_points grows
+        budget = max(2, rect.width() // 2)
+        self._draw_graph_line(painter, rect, self._decimate(downloads, budget),
+                              QColor(52, 152, 219))
+        self._draw_graph_line(painter, rect, self._decimate(uploads, budget),
+                              QColor(46, 204, 113))
+        painter.end()
+
+    def _scroll_and_append(self, rect, uploads, downloads):
+        """Shift the line layer left and draw only the new segment"""
+        if len(uploads) < 2:
+            return
+
+        step_x = rect.width() / (len(uploads) - 1)
+        self._scroll_error += step_x
+        shift = int(self._scroll_error)
+        self._scroll_error -= shift
+        if shift <= 0:
+            return
+        if shift >= rect.width():
+            self._render_plot_full(rect, uploads, downloads)
+            return
+
+        shifted = QPixmap(rect.size())
+        shifted.fill(QColor(0, 0, 0, 0))
+        painter = QPainter(shifted)
+        painter.drawPixmap(-shift, 0, self._plot_cache)
+
+        # Redraw just the strip the new segment lands in. The segment
+        # spans the previous and the new sample, so clear and repaint
+        # one step worth of columns at the right edge.
+        strip_left = rect.width() - shift - int(step_x) - 2
+        painter.setCompositionMode(QPainter.CompositionMode.CompositionMode_Source)
+        painter.fillRect(strip_left, 0, rect.width() - strip_left, rect.height(),
+                         QColor(0, 0, 0, 0))
+        painter.setCompositionMode(QPainter.CompositionMode.CompositionMode_SourceOver)
+        painter.setRenderHint(QPainter.RenderHint.Antialiasing)
+        painter.setClipRect(strip_left, 0, rect.width() - strip_left, rect.height())
+
+        # Draw the tail of each series in plot-local coordinates
+        local = rect.translated(-rect.topLeft())
+        self._draw_graph_tail(painter, local, downloads, step_x, QColor(52, 152, 219))
+        self._draw_graph_tail(painter, local, uploads, step_x, QColor(46, 204, 113))
+        painter.end()
+        self._plot_cache = shifted
+
+    def _draw_graph_tail(self, painter, rect, data, step_x, color):
+        """Draw the final segment of a series (clip limits the cost)"""
+        if len(data) < 2:
+            return
+        data = list(data)
+        x1 = rect.right() - step_x
+        x2 = rect.right()
+        y1 = rect.bottom() - (data[-2] / self.max_value) * rect.height()
+        y2 = rect.bottom() - (data[-1] / self.max_value) * rect.height()
+
+        # Fill under the segment first, then the line on top
+        fill_path = QPainterPath()
+        fill_path.moveTo(x1, rect.bottom())
+        fill_path.lineTo(x1, y1)
+        fill_path.lineTo(x2, y2)
+        fill_path.lineTo(x2, rect.bottom())
+        fill_path.closeSubpath()
+        painter.fillPath(fill_path, QBrush(self._fill_gradient(rect, color)))
+
+        painter.setPen(QPen(color, 2))
+        painter.drawLine(QPointF(x1, y1), QPointF(x2, y2))
+
+    def _fill_gradient(self, rect, color):
+        gradient = QLinearGradient(0, rect.top(), 0, rect.bottom())
+        fill_color = QColor(color)
+        fill_color.setAlpha(60)
+        gradient.setColorAt(0, fill_color)
+        fill_color.setAlpha(10)
+        gradient.setColorAt(1, fill_color)
+        return gradient
+
     def _draw_graph_line(self, painter, rect, data, color):
-        """Draw a graph line with gradient fill"""
+        """Draw a full graph line with gradient fill (plot-local coords)"""
         if len(data) < 2:
             return
-            
+
+        # The plot cache is drawn in its own coordinate space
+        rect = rect.translated(-rect.topLeft())
+
         points = []
         step_x = rect.width() / (len(data) - 1)
-        
+
         for i, value in enumerate(data):
             x = rect.left() + i * step_x
             y = rect.bottom() - (value / self.max_value) * rect.height()
             points.append(QPointF(x, y))
-            
+
         # Create path for line
         path = QPainterPath()
         if points:
             path.moveTo(points[0])
             for point in points[1:]:
                 path.lineTo(point)
-                
+
         # Draw line
         painter.setPen(QPen(color, 2))
         painter.drawPath(path)
-        
+
         # Create filled area under line
         fill_path = QPainterPath()
         if points:
@@ -180,16 +401,8 @@ class RealTimeGraph(QWidget):
                 fill_path.lineTo(point)
             fill_path.lineTo(points[-1].x(), rect.bottom())
             fill_path.closeSubpath()
-            
-            # Gradient fill
-            gradient = QLinearGradient(0, rect.top(), 0, rect.bottom())
-            fill_color = QColor(color)
-            fill_color.setAlpha(60)
-            gradient.setColorAt(0, fill_color)
-            fill_color.setAlpha(10)
-            gradient.setColorAt(1, fill_color)
-            
-            painter.fillPath(fill_path, QBrush(gradient))
+
+            painter.fillPath(fill_path, QBrush(self._fill_gradient(rect, color)))
 
 class MetricCard(QFrame):
     """Beautiful metric display card"""
@@ -283,6 +496,16 @@ class StatusIndicator(QWidget):
     def _update_pulse(self):
         self.pulse_value = (self.pulse_value + 0.1) % (2 * math.pi)
         self.update()
+
+    def hideEvent(self, event):
+        """No pulse timer while invisible (e.g. panel in inactive state)"""
+        self.pulse_timer.stop()
+        super().hideEvent(event)
+
+    def showEvent(self, event):
+        if self.status == "Connected" and not self.pulse_timer.isActive():
+            self.pulse_timer.start(50)
+        super().showEvent(event)
         
     def paintEvent(self, event):
         painter = QPainter(self)
@@ -376,8 +599,34 @@ class TelemetryPanel(QWidget):
         content_layout.setContentsMargins(12, 12, 12, 12)
         content_layout.setSpacing(12)
         
-        # Real-time traffic graph
+        # Real-time traffic graph with timescale selector
         self.traffic_graph = RealTimeGraph("Network Traffic")
+
+        self.timescale_bar = QWidget()
+        timescale_layout = QHBoxLayout(self.timescale_bar)
+        timescale_layout.setContentsMargins(0, 0, 0, 0)
+
+        timescale_label = QLabel("Timescale:")
+        timescale_label.setStyleSheet("color: #95a5a6; font-size: 9pt;")
+        timescale_layout.addWidget(timescale_label)
+
+        self.timescale_selector = QComboBox()
+        self.timescale_selector.addItems(["Live (60 s)", "5 min", "1 hour", "8 hours"])
+        self.timescale_selector.setStyleSheet("""
+            QComboBox {
+                background: #34495e;
+                color: #ecf0f1;
+                border: 1px solid #4a6473;
+                border-radius: 4px;
+                padding: 2px 8px;
+            }
+        """)
+        self.timescale_selector.currentIndexChanged.connect(
+            self.traffic_graph.set_history_tier)
+        timescale_layout.addWidget(self.timescale_selector)
+        timescale_layout.addStretch()
+
+        content_layout.addWidget(self.timescale_bar)
         content_layout.addWidget(self.traffic_graph)
         
         # Metrics grid
@@ -446,10 +695,12 @@ class TelemetryPanel(QWidget):
         
         if active:
             self.inactive_label.hide()
+            self.timescale_bar.show()
             self.traffic_graph.show()
             for card in [self.link_speed_card, self.packets_card, self.errors_card, self.uptime_card]:
                 card.show()
         else:
+            self.timescale_bar.hide()
             self.traffic_graph.hide()
             for card in [self.link_speed_card, self.packets_card, self.errors_card, self.uptime_card]:
                 card.hide()